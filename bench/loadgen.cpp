@@ -0,0 +1,327 @@
+// Synthetic load generator for the game server.
+//
+// Connects N bots to a local server and has each issue commands at a
+// configurable rate, either replaying a script or random-walking through
+// the world. Reports client-observed latency percentiles, throughput and
+// error rates.
+//
+// Usage: loadgen (--unix PATH | --tcp PORT) [--bots N] [--rate R]
+//                [--seconds S] [--script FILE] [--seed N]
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <netinet/in.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const kPrompt = "\n> ";
+const char* const kFarewell = "Thank you for playing";
+const char* const kDirections[] = {"north", "south", "east", "west"};
+
+struct Options {
+    std::string unixPath;
+    int tcpPort = 0;
+    int bots = 10;
+    double rate = 1.0;       // commands per second per bot, 0 = closed loop
+    double seconds = 10.0;
+    std::string scriptPath;
+    unsigned seed = 1;
+};
+
+struct Stats {
+    std::vector<uint64_t> latencies;  // nanoseconds
+    uint64_t sent = 0;
+    uint64_t rejected = 0;      // the game did not understand the command
+    uint64_t connectFailures = 0;
+    uint64_t disconnects = 0;   // connection lost with a command outstanding
+};
+
+struct Bot {
+    int fd = -1;
+    bool ready = false;          // opening text received
+    bool awaiting = false;       // a command is outstanding
+    std::string received;
+    Clock::time_point sentAt;
+    Clock::time_point nextSendAt;
+    size_t scriptIndex = 0;
+    std::vector<std::string> visible;  // item and NPC names from the last response
+    std::vector<std::string> carried;  // items the bot believes it holds
+};
+
+int connectTo(const Options& options) {
+    int fd;
+    if (!options.unixPath.empty()) {
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, options.unixPath.c_str(), sizeof(addr.sun_path) - 1);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            return fd;
+        }
+    } else {
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(options.tcpPort));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            return fd;
+        }
+    }
+    if (fd >= 0) close(fd);
+    return -1;
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+// Remember the "- name" entries the game listed, to pick targets from
+void learnVisible(Bot& bot, const std::string& response) {
+    bot.visible.clear();
+    size_t pos = 0;
+    while ((pos = response.find("\n- ", pos)) != std::string::npos) {
+        size_t end = response.find('\n', pos + 3);
+        std::string name = response.substr(pos + 3, end - pos - 3);
+        if (name.find(':') == std::string::npos) {
+            bot.visible.push_back(toLower(name));
+        }
+        pos = end == std::string::npos ? response.size() : end;
+    }
+}
+
+// Remember the items the game confirmed the bot picked up
+void learnCarried(Bot& bot, const std::string& response) {
+    const std::string taken = "Taken: ";
+    size_t pos = 0;
+    while ((pos = response.find(taken, pos)) != std::string::npos) {
+        size_t end = std::min(response.find('\n', pos), response.size());
+        bot.carried.push_back(toLower(response.substr(pos + taken.size(), end - pos - taken.size())));
+        pos = end;
+    }
+}
+
+std::string randomCommand(Bot& bot, std::mt19937& rng) {
+    std::uniform_int_distribution<int> pick(0, 99);
+    int roll = pick(rng);
+
+    auto choose = [&rng](const std::vector<std::string>& names) {
+        std::uniform_int_distribution<size_t> index(0, names.size() - 1);
+        return names[index(rng)];
+    };
+
+    if (roll < 40) {
+        return std::string("go ") + kDirections[pick(rng) % 4];
+    }
+    if (roll < 55) {
+        return "look";
+    }
+    if (roll < 70 && !bot.visible.empty()) {
+        return "take " + choose(bot.visible);
+    }
+    if (roll < 85 && !bot.visible.empty()) {
+        return "examine " + choose(bot.visible);
+    }
+    if (roll < 95 && !bot.carried.empty()) {
+        return "use " + choose(bot.carried);
+    }
+    return "inventory";
+}
+
+bool isRejected(const std::string& response) {
+    return response.find("Invalid command") != std::string::npos ||
+           response.find("Unknown command") != std::string::npos;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--unix" && hasValue) options.unixPath = argv[++i];
+        else if (arg == "--tcp" && hasValue) options.tcpPort = std::atoi(argv[++i]);
+        else if (arg == "--bots" && hasValue) options.bots = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--rate" && hasValue) options.rate = std::max(0.0, std::atof(argv[++i]));
+        else if (arg == "--seconds" && hasValue) options.seconds = std::atof(argv[++i]);
+        else if (arg == "--script" && hasValue) options.scriptPath = argv[++i];
+        else if (arg == "--seed" && hasValue) options.seed = static_cast<unsigned>(std::atoi(argv[++i]));
+        else {
+            std::cerr << "Usage: " << argv[0] << " (--unix PATH | --tcp PORT) [--bots N] [--rate R]\n"
+                      << "       [--seconds S] [--script FILE] [--seed N]\n";
+            return 1;
+        }
+    }
+    if (options.unixPath.empty() && options.tcpPort == 0) {
+        std::cerr << "Error: give --unix PATH or --tcp PORT\n";
+        return 1;
+    }
+
+    std::vector<std::string> script;
+    if (!options.scriptPath.empty()) {
+        std::ifstream file(options.scriptPath);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line[0] != '#' && line != "quit") script.push_back(line);
+        }
+        if (script.empty()) {
+            std::cerr << "Error: no commands in " << options.scriptPath << "\n";
+            return 1;
+        }
+    }
+
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    std::vector<Bot> bots(static_cast<size_t>(options.bots));
+    Stats stats;
+    std::mt19937 rng(options.seed);
+    const auto interval = options.rate > 0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / options.rate))
+        : Clock::duration::zero();
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < bots.size(); ++i) {
+        Bot& bot = bots[i];
+        bot.fd = connectTo(options);
+        if (bot.fd < 0) {
+            ++stats.connectFailures;
+            continue;
+        }
+        // Spread the first commands so bots do not move in lock step
+        bot.nextSendAt = start + interval * static_cast<long>(i) / static_cast<long>(bots.size());
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = i;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, bot.fd, &event);
+    }
+
+    const auto deadline = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(options.seconds));
+    std::vector<epoll_event> events(256);
+    char buffer[16384];
+
+    while (true) {
+        auto now = Clock::now();
+        if (now >= deadline) break;
+
+        // Send every command that is due and find the next wake-up
+        auto wake = deadline;
+        for (Bot& bot : bots) {
+            if (bot.fd < 0 || !bot.ready || bot.awaiting) continue;
+            if (bot.nextSendAt <= now) {
+                std::string command = script.empty()
+                    ? randomCommand(bot, rng)
+                    : script[bot.scriptIndex++ % script.size()];
+                command += '\n';
+                if (send(bot.fd, command.data(), command.size(), MSG_NOSIGNAL) !=
+                    static_cast<ssize_t>(command.size())) {
+                    ++stats.disconnects;
+                    close(bot.fd);
+                    bot.fd = -1;
+                    continue;
+                }
+                bot.awaiting = true;
+                bot.sentAt = now;
+                ++stats.sent;
+            } else {
+                wake = std::min(wake, bot.nextSendAt);
+            }
+        }
+
+        // Round up so a send due in under a millisecond does not busy-spin
+        auto timeout = std::chrono::ceil<std::chrono::milliseconds>(wake - now).count();
+        int count = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()),
+                               static_cast<int>(std::max<long long>(0, timeout)));
+        if (count < 0 && errno != EINTR) {
+            std::perror("epoll_wait");
+            return 1;
+        }
+
+        now = Clock::now();
+        for (int e = 0; e < count; ++e) {
+            Bot& bot = bots[events[e].data.u64];
+            if (bot.fd < 0) continue;
+
+            ssize_t received = recv(bot.fd, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                if (bot.awaiting) ++stats.disconnects;
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, bot.fd, nullptr);
+                close(bot.fd);
+                bot.fd = -1;
+                continue;
+            }
+            bot.received.append(buffer, static_cast<size_t>(received));
+
+            // A response is complete once the next prompt arrives
+            size_t promptLength = std::strlen(kPrompt);
+            if (bot.received.size() < promptLength ||
+                bot.received.compare(bot.received.size() - promptLength, promptLength, kPrompt) != 0) {
+                if (bot.received.find(kFarewell) != std::string::npos) {
+                    // The script quit; reconnecting would skew the numbers
+                    close(bot.fd);
+                    bot.fd = -1;
+                }
+                continue;
+            }
+
+            if (bot.awaiting) {
+                stats.latencies.push_back(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now - bot.sentAt).count()));
+                if (isRejected(bot.received)) ++stats.rejected;
+                bot.awaiting = false;
+            }
+            learnVisible(bot, bot.received);
+            learnCarried(bot, bot.received);
+            bot.received.clear();
+            bot.ready = true;
+            bot.nextSendAt = std::max(now, bot.sentAt + interval);
+        }
+    }
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    for (Bot& bot : bots) {
+        if (bot.fd >= 0) close(bot.fd);
+    }
+    close(epollFd);
+
+    auto percentile = [&stats](double fraction) {
+        if (stats.latencies.empty()) return 0.0;
+        size_t index = static_cast<size_t>(fraction * static_cast<double>(stats.latencies.size() - 1));
+        std::nth_element(stats.latencies.begin(), stats.latencies.begin() + index, stats.latencies.end());
+        return static_cast<double>(stats.latencies[index]) / 1000.0;
+    };
+
+    size_t completed = stats.latencies.size();
+    std::printf("bots              %d (%llu failed to connect)\n", options.bots,
+                static_cast<unsigned long long>(stats.connectFailures));
+    std::printf("commands          %llu sent, %zu answered in %.1fs (%.0f/s)\n",
+                static_cast<unsigned long long>(stats.sent), completed, elapsed,
+                elapsed > 0 ? static_cast<double>(completed) / elapsed : 0.0);
+    std::printf("latency us        p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n",
+                percentile(0.50), percentile(0.90), percentile(0.99), percentile(1.0));
+    std::printf("rejected          %llu (%.2f%%)\n",
+                static_cast<unsigned long long>(stats.rejected),
+                completed ? 100.0 * static_cast<double>(stats.rejected) / static_cast<double>(completed) : 0.0);
+    std::printf("disconnects       %llu\n", static_cast<unsigned long long>(stats.disconnects));
+    return stats.connectFailures + stats.disconnects > 0 ? 2 : 0;
+}
@@ -0,0 +1,145 @@
+// Replays recorded command transcripts through GameEngine and reports
+// end-to-end turn throughput, per-command latency and allocations per turn.
+//
+// Usage: replay_bench [--iterations N] [--print] TRANSCRIPT...
+
+#include "game_engine.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> allocationCount{0};
+
+struct Transcript {
+    std::string name;
+    std::vector<std::string> commands;
+};
+
+Transcript loadTranscript(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open transcript: " + path);
+    }
+
+    Transcript transcript;
+    transcript.name = path;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        transcript.commands.push_back(line);
+    }
+    return transcript;
+}
+
+// FNV-1a, so the output is consumed and runs can be compared for equality
+uint64_t hashText(uint64_t hash, std::string_view text) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t percentile(std::vector<uint64_t>& samples, double fraction) {
+    if (samples.empty()) return 0;
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+}  // namespace
+
+// Count every allocation made while the benchmark runs
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char* argv[]) {
+    int iterations = 200;
+    bool print = false;
+    std::vector<Transcript> transcripts;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+                iterations = std::max(1, std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--print") == 0) {
+                print = true;
+            } else {
+                transcripts.push_back(loadTranscript(argv[i]));
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (transcripts.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--iterations N] [--print] TRANSCRIPT...\n";
+        return 1;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    std::printf("%-36s %8s %12s %10s %10s %12s %18s\n",
+                "transcript", "turns", "turns/sec", "p50 us", "p99 us", "allocs/turn", "output hash");
+
+    for (const auto& transcript : transcripts) {
+        std::vector<uint64_t> latencies;
+        latencies.reserve(transcript.commands.size() * static_cast<size_t>(iterations));
+        uint64_t hash = 14695981039346656037ULL;
+        uint64_t turnAllocations = 0;
+        Clock::duration turnTime{};
+
+        for (int iteration = 0; iteration < iterations; ++iteration) {
+            GameEngine engine;
+            hash = hashText(hash, engine.start().output);
+
+            for (const auto& command : transcript.commands) {
+                uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+                auto begin = Clock::now();
+                GameEngine::TurnResult result = engine.step(command);
+                auto end = Clock::now();
+                turnAllocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+                hash = hashText(hash, result.output);
+                if (print && iteration == 0) {
+                    std::cout << "> " << command << "\n" << result.output << "\n";
+                }
+
+                turnTime += end - begin;
+                latencies.push_back(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+            }
+        }
+
+        size_t turns = latencies.size();
+        double seconds = std::chrono::duration<double>(turnTime).count();
+        double p50 = static_cast<double>(percentile(latencies, 0.50)) / 1000.0;
+        double p99 = static_cast<double>(percentile(latencies, 0.99)) / 1000.0;
+
+        std::printf("%-36s %8zu %12.0f %10.2f %10.2f %12.1f %016llx\n",
+                    transcript.name.c_str(), turns,
+                    seconds > 0 ? static_cast<double>(turns) / seconds : 0.0,
+                    p50, p99,
+                    turns ? static_cast<double>(turnAllocations) / static_cast<double>(turns) : 0.0,
+                    static_cast<unsigned long long>(hash));
+    }
+    return 0;
+}
@@ -96,13 +96,13 @@ class BookSortingPuzzle : public Puzzle {
      * @param attempt Unused parameter (required by base class)
      * @return true if current arrangement is valid
      */
-    bool AttemptSolution(const std::string& attempt = "") override;
+    bool AttemptSolution(std::string_view attempt = "") override;
 
     /**
      * @brief Get hint for puzzle
      * @return Hint string
      */
-    std::string GetHint() const override;
+    std::string_view GetHint() const override;
 
     /**
      * @brief Reset puzzle to initial state
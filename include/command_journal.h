@@ -0,0 +1,120 @@
+#ifndef COMMAND_JOURNAL_H_
+#define COMMAND_JOURNAL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class CommandJournal
+ * @brief Append-only log of state-changing commands for one session
+ *
+ * A journal directory holds `journal.log` and at most a couple of
+ * `checkpoint-N.snap` snapshots. The log starts with a line `@N` naming the
+ * checkpoint its entries apply on top of (0 for a freshly built world),
+ * followed by one command per line.
+ *
+ * Appends are buffered and written with a single write() and fdatasync()
+ * per group commit. A checkpoint writes the new snapshot first, then
+ * atomically replaces the log with an empty one pointing at it, so a crash
+ * at any point recovers to a consistent "checkpoint + tail".
+ */
+class CommandJournal {
+ public:
+    /**
+     * @brief State found in a journal directory
+     */
+    struct Recovery {
+        uint64_t checkpoint = 0;            ///< Checkpoint to load first, 0 for none
+        std::vector<std::string> commands;  ///< Commands to replay on top of it
+    };
+
+    /**
+     * @brief Read the recoverable state of a journal directory
+     *
+     * A torn final line from an interrupted write is ignored.
+     *
+     * @param directory The journal directory
+     * @return The checkpoint and commands to replay, empty if there is no journal
+     */
+    static Recovery recover(const std::string& directory);
+
+    /**
+     * @brief Open a journal for appending
+     * @param directory The journal directory, created if missing
+     * @param recovery State returned by recover() for the same directory
+     * @param groupSize Entries buffered before a commit happens automatically
+     * @throws std::runtime_error if the journal cannot be opened
+     */
+    CommandJournal(const std::string& directory, const Recovery& recovery, size_t groupSize = 16);
+
+    /**
+     * @brief Destructor, commits buffered entries
+     */
+    ~CommandJournal();
+
+    CommandJournal(const CommandJournal&) = delete;
+    CommandJournal& operator=(const CommandJournal&) = delete;
+
+    /**
+     * @brief Buffer a command, committing if the group is full
+     * @param command The command line, without a newline
+     */
+    void append(std::string_view command);
+
+    /**
+     * @brief Write and sync all buffered entries
+     * @throws std::runtime_error if the write fails
+     */
+    void commit();
+
+    /**
+     * @brief Get the path where the next checkpoint snapshot must be written
+     * @return Snapshot path for checkpoint getCheckpoint() + 1
+     */
+    std::string nextCheckpointPath() const;
+
+    /**
+     * @brief Start a new log on top of the snapshot at nextCheckpointPath()
+     * @throws std::runtime_error if the log cannot be replaced
+     */
+    void completeCheckpoint();
+
+    /**
+     * @brief Get the path of a checkpoint snapshot
+     * @param checkpoint Checkpoint number
+     * @return Path of the snapshot file
+     */
+    std::string checkpointPath(uint64_t checkpoint) const;
+
+    /**
+     * @brief Get the checkpoint the log applies on top of
+     * @return Checkpoint number, 0 for none
+     */
+    uint64_t getCheckpoint() const { return checkpoint_; }
+
+    /**
+     * @brief Get the number of entries logged since the last checkpoint
+     * @return Entry count
+     */
+    size_t getEntryCount() const { return entries_; }
+
+ private:
+    std::string directory_;  ///< Journal directory
+    int fd_;                 ///< journal.log, opened for appending
+    std::string buffer_;     ///< Entries not yet committed
+    size_t buffered_;        ///< Number of entries in buffer_
+    size_t groupSize_;       ///< Commit automatically at this many entries
+    uint64_t checkpoint_;    ///< Checkpoint the log applies on top of
+    size_t entries_;         ///< Entries since the checkpoint
+
+    /**
+     * @brief Get the path of the log file
+     * @return Path of journal.log
+     */
+    std::string logPath() const;
+};
+
+#endif  // COMMAND_JOURNAL_H_
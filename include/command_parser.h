@@ -1,9 +1,12 @@
 #ifndef COMMAND_PARSER_H_
 #define COMMAND_PARSER_H_
 
+#include "symbol_table.h"
+#include <array>
+#include <cstddef>
+#include <span>
 #include <string>
-#include <vector>
-#include <utility>
+#include <string_view>
 
 /**
  * @class CommandParser
@@ -11,45 +14,101 @@
  * 
  * This class handles all command parsing, input validation, and initial processing
  * of user commands before they are executed by the game engine.
+ *
+ * Each parser owns a line buffer that is reused from turn to turn. The
+ * returned Command only holds string_views into that buffer, so parsing does
+ * no heap allocation once the buffer has grown to the longest line seen, and
+ * a Command stays valid until the next parseInput() call on the same parser.
+ *
+ * One line may hold several commands separated by commas, "then" or "and",
+ * as in "go north, take quest scroll then look". parseBatch() splits such a
+ * line into a batch that the engine runs in order.
+ *
+ * Each command is split into a verb, a direct object, a preposition and an
+ * indirect object, so "use the crystal lens on the mirror" has the noun
+ * "crystal lens" and the indirect object "mirror". Articles, prepositions
+ * and separators are looked up in a word table fixed at compile time.
+ * Adjectives need no rule of their own: they are part of entity names
+ * ("silver key"), which the engine matches by any word.
  */
 class CommandParser {
  public:
+    static constexpr size_t kMaxTokens = 32;   ///< Longest accepted line in words, separators included
+    static constexpr size_t kMaxCommands = 8;  ///< Most commands accepted in one line
+
+    /**
+     * @brief Why the last parseBatch() returned no commands
+     */
+    enum class Error {
+        kNone,             ///< The line parsed, though it may have held no command
+        kInvalid,          ///< Blank line, or characters the parser does not accept
+        kTooManyWords,     ///< More than kMaxTokens words, separators included
+        kTooManyCommands,  ///< More than kMaxCommands commands
+    };
+
     /**
      * @brief Structure to hold a parsed command
      */
     struct Command {
-        std::string action;                  ///< The main command action
-        std::vector<std::string> arguments;  ///< Command arguments
-        bool isValid;                        ///< Indicates if the command is valid
+        std::string_view action;                      ///< The main command action, lowercase
+        std::span<const std::string_view> arguments;  ///< Words after the action, lowercase
+        std::string_view noun;                        ///< Direct object: words up to any preposition, less a leading article
+        Symbol object = kNoSymbol;                    ///< The noun as an entity name, kNoSymbol if none has it
+        std::string_view preposition;                 ///< Word introducing the indirect object, empty if none
+        std::string_view indirect;                    ///< Indirect object: words after the preposition, less a leading article
+        Symbol indirectObject = kNoSymbol;            ///< The indirect object as an entity name
+        bool isValid = false;                         ///< Indicates if the command is valid
     };
 
     /**
-     * @brief Get input from the user and process it
-     * @return Command structure containing the processed input
+     * @brief Process a raw input string into a command
+     *
+     * Letters, digits, whitespace and non-ASCII UTF-8 characters are
+     * accepted; punctuation, malformed UTF-8 and commands with more than
+     * kMaxTokens words are rejected. So is a line holding several commands.
+     *
+     * @param input The raw input string to process
+     * @return Command structure viewing this parser's buffer
      */
-    Command getCommand();
+    Command parseInput(std::string_view input);
 
     /**
-     * @brief Process a raw input string into a command
+     * @brief Process a raw input string into a batch of commands
+     *
+     * Accepts the same text as parseInput(), plus commas. Commas and the
+     * words "then" and "and" separate commands; empty commands are skipped.
+     *
      * @param input The raw input string to process
-     * @return Command structure containing the processed command
+     * @return The commands in input order, viewing this parser's buffers;
+     *         empty if the line is blank or invalid, see getError()
      */
-    Command parseInput(const std::string& input);
+    std::span<const Command> parseBatch(std::string_view input);
 
- private:
     /**
-     * @brief Check if the input contains only valid characters
-     * @param input String to validate
-     * @return true if input is valid, false otherwise
+     * @brief Get the reason the last parsed line was rejected
+     * @return Error::kNone if it was accepted
      */
-    bool isValidInput(const std::string& input) const;
+    Error getError() const { return error_; }
 
     /**
-     * @brief Convert a string to lowercase
-     * @param input String to convert
-     * @return Lowercase version of the input string
+     * @brief Check whether a word is an article the parser drops
+     * @param word A lowercase word
+     * @return true for "a", "an" and "the"
      */
-    std::string toLowerCase(const std::string& input) const;
+    static bool isArticle(std::string_view word);
+
+    /**
+     * @brief Check whether a word introduces an indirect object
+     * @param word A lowercase word
+     * @return true for prepositions such as "on" and "to"
+     */
+    static bool isPreposition(std::string_view word);
+
+ private:
+    std::string line_;                                ///< Lowercased input, words separated by one space
+    std::array<std::string_view, kMaxTokens> tokens_; ///< Words of line_
+    std::array<Command, kMaxCommands> commands_;      ///< Commands of the last batch
+    Error error_ = Error::kNone;                      ///< Why the last batch was rejected
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,90 @@
+#ifndef CONTENT_STORE_H_
+#define CONTENT_STORE_H_
+
+#include "epoch_reclaimer.h"
+#include "world_content.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+/**
+ * @class ContentStore
+ * @brief Publishes WorldContent to running sessions without stopping them
+ *
+ * Sessions read the current content through a Reader, which costs one
+ * atomic load plus the EpochReclaimer announcement and never takes a lock.
+ * publish() swaps in a new definition; the old one is destroyed only after
+ * every Reader that might still see it has gone away, so a reload never
+ * disturbs a turn in progress. If Readers were active during publish(), the
+ * old definition is freed by a later collect() once they have finished.
+ */
+class ContentStore {
+ public:
+    /**
+     * @class Reader
+     * @brief Pins the content that was current when it was created
+     */
+    class Reader {
+     public:
+        /**
+         * @brief Constructor for Reader
+         * @param store The store to read from
+         */
+        explicit Reader(const ContentStore& store)
+            : content_(store.current_.load()) {}
+
+        const WorldContent& operator*() const { return *content_; }
+        const WorldContent* operator->() const { return content_; }
+
+     private:
+        EpochReclaimer::ReadGuard guard_;  ///< Announced before content_ is loaded (seq_cst)
+        const WorldContent* content_;      ///< The pinned content
+    };
+
+    /**
+     * @brief Constructor for ContentStore, starts with empty content
+     */
+    ContentStore();
+
+    /**
+     * @brief Destructor, no Reader may outlive the store
+     */
+    ~ContentStore();
+
+    ContentStore(const ContentStore&) = delete;
+    ContentStore& operator=(const ContentStore&) = delete;
+
+    /**
+     * @brief Replace the current content
+     * @param content The new content, must not be null
+     */
+    void publish(std::unique_ptr<const WorldContent> content);
+
+    /**
+     * @brief Destroy replaced content that no Reader can still see
+     *
+     * Meant for idle points between turns; cheap when nothing is pending.
+     */
+    void collect() { reclaimer_.collect(); }
+
+    /**
+     * @brief Get the number of replaced definitions not yet destroyed
+     * @return Retired content count
+     */
+    size_t getRetiredCount() const { return reclaimer_.getPendingCount(); }
+
+    /**
+     * @brief Get the number of publications so far
+     * @return Version of the current content, 0 for the initial empty content
+     */
+    uint64_t getVersion() const { return version_.load(std::memory_order_acquire); }
+
+ private:
+    std::atomic<const WorldContent*> current_;  ///< Content handed to new readers
+    std::atomic<uint64_t> version_;             ///< Number of publications
+    std::mutex publishMutex_;                   ///< Serializes writers
+    EpochReclaimer reclaimer_;                  ///< Destroys replaced content
+};
+
+#endif  // CONTENT_STORE_H_
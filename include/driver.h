@@ -0,0 +1,39 @@
+#ifndef DRIVER_H_
+#define DRIVER_H_
+
+#include <iosfwd>
+
+class GameEngine;
+
+/**
+ * @class Driver
+ * @brief Console front-end for a GameEngine
+ *
+ * Reads one line at a time from an input stream, feeds it to
+ * GameEngine::step() and writes each turn's text together with the next
+ * prompt in a single writev call. All blocking I/O lives here so the engine
+ * itself stays embeddable.
+ */
+class Driver {
+ public:
+    /**
+     * @brief Constructor for Driver
+     * @param engine The engine to drive
+     * @param in Stream to read player commands from
+     * @param outFd File descriptor to write game text to
+     */
+    Driver(GameEngine& engine, std::istream& in, int outFd);
+
+    /**
+     * @brief Run the game until the player quits or input ends
+     * @return Number of turns executed
+     */
+    int run();
+
+ private:
+    GameEngine& engine_;  ///< Engine being driven
+    std::istream& in_;    ///< Source of player commands
+    int outFd_;           ///< Destination for game text
+};
+
+#endif  // DRIVER_H_
@@ -1,20 +1,38 @@
 #ifndef ENTITY_H
 #define ENTITY_H
 
+#include "symbol_table.h"
+#include <cctype>
 #include <string>
+#include <string_view>
 
 class Entity {
 public:
     Entity(const std::string& name, const std::string& description)
-        : name(name), description(description) {}
+        : name(name), description(description), symbol(SymbolTable::global().intern(name)) {}
 
-    std::string getName() const { return name; }
-    std::string getDescription() const { return description; }
+    const std::string& getName() const { return name; }
+    const std::string& getDescription() const { return description; }
     virtual std::string Examine() const { return description; }
 
+    // The interned name; entities with equal names share a symbol
+    Symbol getSymbol() const { return symbol; }
+    bool isNamed(Symbol other) const { return symbol == other; }
+
+    // Player input is lowercased, so names compare without regard to case
+    bool isNamed(std::string_view other) const {
+        if (other.size() != name.size()) return false;
+        for (size_t i = 0; i < other.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(name[i])) !=
+                std::tolower(static_cast<unsigned char>(other[i]))) return false;
+        }
+        return true;
+    }
+
 protected:
     std::string name;
     std::string description;
+    Symbol symbol;
 };
 
 #endif // ENTITY_H
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define ENVIRONMENT_BUILDER_H_
 
 #include "location_grid.h"
+#include "location_store.h"
 #include "environment_type.h"
 #include <memory>
 #include <string>
@@ -19,9 +20,10 @@ class EnvironmentBuilder {
     /**
      * @brief Build a complete environment based on type
      * @param type The type of environment to create
+     * @param store Store that receives the environment's locations
      * @return Unique pointer to the created environment
      */
-    static std::unique_ptr<LocationGrid> buildEnvironment(EnvironmentType type);
+    static std::unique_ptr<LocationGrid> buildEnvironment(EnvironmentType type, LocationStore& store);
 
  private:
     /**
@@ -41,65 +43,76 @@ class EnvironmentBuilder {
 
     /**
      * @brief Create the Village of Luminara environment
+     * @param store Store that receives the locations
      * @return Unique pointer to the created environment
      */
-    static std::unique_ptr<LocationGrid> createVillageOfLuminara();
+    static std::unique_ptr<LocationGrid> createVillageOfLuminara(LocationStore& store);
 
     /**
      * @brief Create the Whispering Woods environment
+     * @param store Store that receives the locations
      * @return Unique pointer to the created environment
      */
-    static std::unique_ptr<LocationGrid> createWhisperingWoods();
+    static std::unique_ptr<LocationGrid> createWhisperingWoods(LocationStore& store);
 
     /**
      * @brief Create the Crystal Caves environment
+     * @param store Store that receives the locations
      * @return Unique pointer to the created environment
      */
-    static std::unique_ptr<LocationGrid> createCrystalCaves();
+    static std::unique_ptr<LocationGrid> createCrystalCaves(LocationStore& store);
 
     /**
      * @brief Create the Forgotten Library environment
+     * @param store Store that receives the locations
      * @return Unique pointer to the created environment
      */
-    static std::unique_ptr<LocationGrid> createForgottenLibrary();
+    static std::unique_ptr<LocationGrid> createForgottenLibrary(LocationStore& store);
 
     /**
      * @brief Create the Echoing Mountains environment
+     * @param store Store that receives the locations
      * @return Unique pointer to the created environment
      */
-    static std::unique_ptr<LocationGrid> createEchoingMountains();
+    static std::unique_ptr<LocationGrid> createEchoingMountains(LocationStore& store);
 
     /**
      * @brief Create the Shadow Marshes environment
+     * @param store Store that receives the locations
      * @return Unique pointer to the created environment
      */
-    static std::unique_ptr<LocationGrid> createShadowMarshes();
+    static std::unique_ptr<LocationGrid> createShadowMarshes(LocationStore& store);
 
     /**
      * @brief Create the Sanctum of Light environment
+     * @param store Store that receives the locations
      * @return Unique pointer to the created environment
      */
-    static std::unique_ptr<LocationGrid> createSanctumOfLight();
+    static std::unique_ptr<LocationGrid> createSanctumOfLight(LocationStore& store);
 
     /**
      * @brief Create Malakar's Lair environment
+     * @param store Store that receives the locations
      * @return Unique pointer to the created environment
      */
-    static std::unique_ptr<LocationGrid> createMalakarsLair();
+    static std::unique_ptr<LocationGrid> createMalakarsLair(LocationStore& store);
 
     /**
      * @brief Create the Hidden Grove environment
+     * @param store Store that receives the locations
      * @return Unique pointer to the created environment
      */
-    static std::unique_ptr<LocationGrid> createHiddenGrove();
+    static std::unique_ptr<LocationGrid> createHiddenGrove(LocationStore& store);
 
     /**
      * @brief Helper function to create a basic 3x3 grid
+     * @param store Store that receives the locations
      * @param name Environment name
      * @param locations Array of location data for each grid position
      * @return Created environment grid
      */
     static std::unique_ptr<LocationGrid> createBasicGrid(
+        LocationStore& store,
         const std::string& name,
         const std::array<std::array<LocationData, LocationGrid::GRID_SIZE>,
                         LocationGrid::GRID_SIZE>& locations);
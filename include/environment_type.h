@@ -14,7 +14,18 @@ enum class EnvironmentType {
     SHADOW_MARSHES,
     SANCTUM_OF_LIGHT,
     MALAKARS_LAIR,
-    HIDDEN_GROVE
+    HIDDEN_GROVE,
+    MARSH_WILDS,      ///< Procedural marshland around the Shadow Marshes
+    MOUNTAIN_WILDS    ///< Procedural wilderness beyond the Echoing Mountains
 };
 
+/**
+ * @brief Check whether an environment is generated rather than handcrafted
+ * @param type The environment type
+ * @return true if its locations come from a ProceduralRegion
+ */
+constexpr bool isProcedural(EnvironmentType type) {
+    return type == EnvironmentType::MARSH_WILDS || type == EnvironmentType::MOUNTAIN_WILDS;
+}
+
 #endif
\ No newline at end of file
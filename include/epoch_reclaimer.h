@@ -0,0 +1,91 @@
+#ifndef EPOCH_RECLAIMER_H_
+#define EPOCH_RECLAIMER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class EpochReclaimer
+ * @brief Deferred destruction of data that lock-free readers may still hold
+ *
+ * Readers wrap each access in a ReadGuard, which announces the current
+ * global epoch in a per-thread slot: two atomic stores and no lock. A writer
+ * that unpublishes an object retire()s it; the global epoch is advanced and
+ * the object is destroyed once no reader is still inside an older epoch.
+ * retire() destroys what it can right away; objects that readers were still
+ * holding then wait for the next retire() or collect(), which owners call
+ * at idle points so the last retired object does not linger.
+ *
+ * The epoch and the reader slots are shared by every reclaimer in the
+ * process, so a thread claims its slot once and keeps it until it exits.
+ */
+class EpochReclaimer {
+ public:
+    /**
+     * @class ReadGuard
+     * @brief Keeps retired objects alive while the calling thread reads them
+     *
+     * Guards nest; only the outermost one on a thread announces an epoch.
+     */
+    class ReadGuard {
+     public:
+        ReadGuard();
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+
+    EpochReclaimer() = default;
+
+    /**
+     * @brief Destructor, destroys every retired object
+     *
+     * No reader may still hold a retired object at this point.
+     */
+    ~EpochReclaimer();
+
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    /**
+     * @brief Destroy an unpublished object once current readers are done
+     *
+     * The object must already be unreachable for new readers.
+     *
+     * @param destroy Callback that frees the object
+     */
+    void retire(std::function<void()> destroy);
+
+    /**
+     * @brief Destroy every retired object no reader can still see
+     *
+     * Cheap when nothing is pending, so it may be called often.
+     */
+    void collect();
+
+    /**
+     * @brief Get the number of retired objects not yet destroyed
+     * @return Pending object count
+     */
+    size_t getPendingCount() const;
+
+ private:
+    /**
+     * @brief An unpublished object waiting for its readers to leave
+     */
+    struct Retired {
+        uint64_t epoch;                 ///< First epoch in which readers cannot see it
+        std::function<void()> destroy;  ///< Frees the object
+    };
+
+    mutable std::mutex mutex_;        ///< Guards retired_
+    std::vector<Retired> retired_;    ///< Objects waiting for destruction
+    std::atomic<size_t> pending_{0};  ///< Size of retired_, readable without the lock
+};
+
+#endif  // EPOCH_RECLAIMER_H_
@@ -1,11 +1,23 @@
 #ifndef GAME_ENGINE_H_
 #define GAME_ENGINE_H_
 
+#include "command_journal.h"
 #include "command_parser.h"
+#include "name_index.h"
+#include "content_store.h"
 #include "game_world.h"
+#include "output_buffer.h"
 #include "player.h"
+#include "session_task.h"
+#include <array>
+#include <cstdint>
+#include <cstddef>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 /**
  * @class GameEngine
@@ -14,19 +26,149 @@
  * This class manages the game loop, processes commands, and coordinates
  * between different game components. It handles all primary game functionality
  * including movement, environment interaction, and game state management.
+ *
+ * The engine never reads input itself: callers feed it one line at a time
+ * through step(), which makes it usable from the console Driver as well as
+ * from headless harnesses that run many games in-process.
+ *
+ * Interactions that span several lines (answering a riddle, arranging
+ * mirrors) are written as SessionTask coroutines that co_await the next
+ * line; while one is active, step() hands input to it instead of the parser.
+ *
+ * With a journal open, every turn that changes state (and every line of a
+ * dialog) is appended to a CommandJournal, and the session is compacted into
+ * a snapshot every few turns, so a crashed session can be rebuilt by loading
+ * the last checkpoint and replaying the journal tail.
  */
+class RiddlePuzzle;
+class ReflectionPuzzle;
+class BookSortingPuzzle;
+
 class GameEngine {
 public:
+    /**
+     * @brief Outcome of a single game turn
+     */
+    struct TurnResult {
+        std::string_view output;       ///< Text produced during the turn, valid until the next start() or step()
+        bool locationChanged = false;  ///< The player moved to another location
+        bool inventoryChanged = false; ///< The player's inventory was modified
+        bool worldChanged = false;     ///< Items were added to or removed from a location, or locations came or went
+        bool quit = false;             ///< The player asked to leave the game
+    };
+
+    /**
+     * @brief Ways to finish a partly typed command
+     */
+    struct Completions {
+        size_t replaceFrom = 0;                        ///< Offset in the typed text where the completed word starts
+        std::span<const std::string_view> candidates;  ///< Replacements for the text from replaceFrom on, best first
+    };
+
     /**
      * @brief Constructor for GameEngine
      */
     GameEngine();
 
     /**
-     * @brief Start the game loop
+     * @brief Start the game loop on standard input and output
      */
     void run();
 
+    /**
+     * @brief Initialize the game and produce the opening text
+     * @return Turn result holding the welcome message and starting location
+     */
+    TurnResult start();
+
+    /**
+     * @brief Execute one line of player input
+     *
+     * Starts the game first if start() has not been called yet. Never blocks.
+     *
+     * @param input The raw input line, without a trailing newline
+     * @return Turn result holding the produced text and state-change flags
+     */
+    TurnResult step(std::string_view input);
+
+    /**
+     * @brief Suggest ways to finish a partly typed command
+     *
+     * The first word completes to verbs and to the exits of the current
+     * location; after a movement verb, to exits; after an item verb, to the
+     * names of visible items, NPCs and inventory entries. Only indexes the
+     * engine already keeps up to date are read, and nothing is allocated
+     * once the candidate buffer has grown, so it can run on every keystroke.
+     *
+     * @param prefix The text typed so far
+     * @return Completions viewing engine data, valid until the next
+     *         complete(), start() or step()
+     */
+    Completions complete(std::string_view prefix);
+
+    /**
+     * @brief Save the session to a binary snapshot file
+     * @param path Destination file
+     * @throws std::runtime_error if the game has not started or the file cannot be written
+     */
+    void saveSnapshot(const std::string& path) const;
+
+    /**
+     * @brief Replace the session with one restored from a snapshot file
+     *
+     * The current session is kept if the snapshot cannot be loaded.
+     *
+     * @param path Snapshot file to read
+     * @throws std::runtime_error if the snapshot is missing or invalid
+     */
+    void loadSnapshot(const std::string& path);
+
+    /**
+     * @brief Recover a journaled session and keep journaling to it
+     *
+     * Loads the latest checkpoint in the directory, or builds a fresh world if
+     * there is none, and replays the commands logged since then. Every later
+     * state-changing turn is appended to the journal.
+     *
+     * @param directory Journal directory, created if missing
+     * @param checkpointInterval Journaled turns between snapshots
+     * @return Number of commands replayed
+     * @throws std::runtime_error if the journal or its checkpoint cannot be used
+     */
+    size_t openJournal(const std::string& directory, size_t checkpointInterval = 100);
+
+    /**
+     * @brief Durably write journal entries buffered since the last commit
+     *
+     * Callers invoke this once per batch of turns, before waiting for more
+     * input; without an open journal it does nothing.
+     */
+    void commitJournal();
+
+    /**
+     * @brief Show location and item text from published world content
+     *
+     * The store may be shared by many engines on different threads and must
+     * outlive this one. Content published later shows up on the next turn.
+     *
+     * @param content The store to read from, nullptr for the built-in text only
+     */
+    void setContentStore(const ContentStore* content) {
+        content_ = content;
+        ++worldVersion_;
+    }
+
+    /**
+     * @brief Use idle time to render the locations one move away
+     *
+     * Meant to be called while the session waits for input. The next move
+     * into a neighbour then copies its ready view instead of building it.
+     * Views are dropped once the world or the published content changes.
+     * Environments next to the current one are built here too, so crossing
+     * into one does not pay for its construction.
+     */
+    void prerender();
+
     /**
      * @brief Check if the game is still running
      * @return true if the game is running
@@ -39,10 +181,41 @@ public:
     void stop();
 
 private:
+    struct Verbs;                                ///< Verb dispatch table, defined in game_engine.cpp
+
     bool running_;                               ///< Flag indicating if game is running
     CommandParser commandParser_;                ///< Parser for handling user input
     std::unique_ptr<GameWorld> gameWorld_;       ///< The game world instance
     std::unique_ptr<Player> currentPlayer_;      ///< The current player instance
+    OutputBuffer output_;                        ///< Text produced by the current turn
+    TurnResult turn_;                            ///< Result of the turn in progress
+    BasicLineInput<std::string_view> dialogInput_;  ///< Lines for the active dialog, viewing step()'s input
+    SessionTask dialog_;                         ///< Multi-line interaction in progress, if any
+    std::unique_ptr<CommandJournal> journal_;    ///< Log of state-changing turns, if enabled
+    size_t checkpointInterval_;                  ///< Journaled turns between snapshots
+    const ContentStore* content_;                ///< Published text overriding the built-in world, if any
+    NameIndex nouns_;                            ///< Names of visible items and NPCs, including the inventory
+    bool deferLocation_;                         ///< Whether showLocation() waits for the end of the batch
+    bool locationPending_;                       ///< Whether a deferred location view is owed
+    std::vector<std::string_view> completions_;  ///< Candidates of the last complete() call
+
+    /**
+     * @brief A location view rendered ahead of time
+     */
+    struct PrerenderedView {
+        const Location* location = nullptr;  ///< Location shown, nullptr if the slot is empty
+        uint64_t worldVersion = 0;           ///< worldVersion_ when rendered
+        uint64_t contentVersion = 0;         ///< Content version when rendered
+        OutputBuffer text;                   ///< What displayCurrentLocation() would write
+    };
+
+    uint64_t worldVersion_;                          ///< Bumped whenever rendered location text may change
+    std::array<PrerenderedView, 4> neighbourViews_;  ///< Views of the neighbours, by direction
+
+    static constexpr size_t kTurnArenaSize = 4096;   ///< Bytes of turnArena_ before it falls back to the heap
+
+    alignas(std::max_align_t) std::array<std::byte, kTurnArenaSize> turnBuffer_;  ///< Storage for turnArena_
+    std::pmr::monotonic_buffer_resource turnArena_;  ///< Scratch memory of the current turn, released by beginTurn()
 
     /**
      * @brief Initialize the game
@@ -52,45 +225,155 @@ private:
 
     /**
      * @brief Process a single game turn
-     * Handles command input and execution
+     * Parses one input line and executes the resulting commands in order,
+     * stopping at the first that fails. A batch of several commands shows
+     * the location at most once, after the last command that ran.
+     * @param input The raw input line
+     * @return The input to journal: the whole line, or only the commands
+     *         before a quit, empty if the quit came first
+     */
+    std::string_view processTurn(std::string_view input);
+
+    /**
+     * @brief Reset the output buffer and flags for a new turn
+     */
+    void beginTurn();
+
+    /**
+     * @brief Attach the text of the current turn to the turn result
+     * @return The finished turn result
+     */
+    TurnResult finishTurn();
+
+    /**
+     * @brief Journal the turn that just ran and checkpoint when due
+     * @param input The input of the turn to log, empty to log nothing
+     * @param inDialog Whether a dialog was active when the turn started
+     */
+    void recordTurn(std::string_view input, bool inDialog);
+
+    /**
+     * @brief Initialize the game and write the opening text
      */
-    void processTurn();
+    void openGame();
 
     /**
      * @brief Execute a parsed command
+     * Looks the verb up in the Verbs table and calls its handler. Bare
+     * directions, verb abbreviations and abbreviated item names are expanded
+     * first; near misses get a "did you mean" hint instead.
      * @param command The command to execute
+     * @return false if the command could not be carried out
+     */
+    bool executeCommand(const CommandParser::Command& command);
+
+    /**
+     * @brief Expand an abbreviated name of something visible
+     * @param phrase The name as typed; replaced by the full name if it resolves
+     * @param symbol Replaced by the symbol of the full name if it resolves
+     * @return false, after suggesting a near miss, if the name is a typo
+     */
+    bool resolveName(std::string_view& phrase, Symbol& symbol);
+
+    /**
+     * @brief Add or remove the names of a location's items and NPCs in nouns_
+     * @param location The location, may be null
+     * @param visible true when the player arrives, false when leaving
      */
-    void executeCommand(const CommandParser::Command& command);
+    void indexLocation(const Location* location, bool visible);
+
+    /**
+     * @brief Rebuild nouns_ from the current location and inventory
+     */
+    void rebuildNameIndex();
 
     /**
      * @brief Handle movement commands
      * @param command The movement command to process
+     * @return false if the command failed
      */
-    void handleMovement(const CommandParser::Command& command);
+    bool handleMovement(const CommandParser::Command& command);
 
     /**
      * @brief Handle examine commands
      * @param command The examine command to process
+     * @return false if the command failed
      */
-    void handleExamine(const CommandParser::Command& command);
+    bool handleExamine(const CommandParser::Command& command);
 
     /**
      * @brief Handle pickup commands
      * @param command The pickup command to process
+     * @return false if the command failed
      */
-    void handlePickup(const CommandParser::Command& command);
+    bool handlePickup(const CommandParser::Command& command);
 
     /**
      * @brief Handle drop commands
      * @param command The drop command to process
+     * @return false if the command failed
      */
-    void handleDrop(const CommandParser::Command& command);
+    bool handleDrop(const CommandParser::Command& command);
 
     /**
      * @brief Handle use commands
      * @param command The use command to process
+     * @return false if the command failed
+     */
+    bool handleUse(const CommandParser::Command& command);
+
+    /**
+     * @brief Handle give commands
+     * Hands an inventory item to an NPC here that has a use for it
+     * @param command The give command to process
+     * @return false if the command failed
+     */
+    bool handleGive(const CommandParser::Command& command);
+
+    /**
+     * @brief Handle solve commands
+     * Starts the dialog for the puzzle at the current location
+     * @param command The solve command to process
+     * @return false if the command failed
+     */
+    bool handleSolve(const CommandParser::Command& command);
+
+    /**
+     * @brief Start a dialog coroutine and run it to its first prompt
+     * @param dialog The dialog to start
      */
-    void handleUse(const CommandParser::Command& command);
+    void startDialog(SessionTask dialog);
+
+    /**
+     * @brief Dialog for answering a riddle
+     * @param puzzle The riddle being answered
+     * @return The dialog coroutine
+     */
+    SessionTask riddleDialog(std::shared_ptr<RiddlePuzzle> puzzle);
+
+    /**
+     * @brief Dialog for placing and rotating mirrors
+     * @param puzzle The reflection puzzle being worked on
+     * @return The dialog coroutine
+     */
+    SessionTask reflectionDialog(std::shared_ptr<ReflectionPuzzle> puzzle);
+
+    /**
+     * @brief Dialog for arranging books on a shelf
+     * @param puzzle The book sorting puzzle being worked on
+     * @return The dialog coroutine
+     */
+    SessionTask bookSortingDialog(std::shared_ptr<BookSortingPuzzle> puzzle);
+
+    /**
+     * @brief Show the current location, or defer it to the end of the batch
+     */
+    void showLocation();
+
+    /**
+     * @brief Display the location view deferred by showLocation(), if any
+     */
+    void flushLocation();
 
     /**
      * @brief Display the current location details
@@ -98,9 +381,28 @@ private:
      */
     void displayCurrentLocation();
 
+    /**
+     * @brief Write the view of a location
+     * @param location The location to show
+     * @param out Buffer receiving the text
+     */
+    void renderLocation(const Location& location, OutputBuffer& out) const;
+
+    /**
+     * @brief Get the version of the published content, 0 without a store
+     * @return Content version
+     */
+    uint64_t getContentVersion() const;
+
+    /**
+     * @brief Display an item's description
+     * @param item The item to describe
+     */
+    void displayItemDescription(const Item& item);
+
     /**
      * @brief Display the help message
-     * Shows available commands and their usage
+     * Lists every verb in the Verbs table, grouped by category
      */
     void displayHelp();
 
@@ -0,0 +1,243 @@
+#ifndef GAME_SERVER_H_
+#define GAME_SERVER_H_
+
+#include "game_engine.h"
+#include "session_task.h"
+#include "turn_scheduler.h"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class GameServer
+ * @brief Hosts many concurrent game sessions in a single process
+ *
+ * Listens on a Unix-domain socket and/or a localhost TCP port. Every
+ * accepted connection gets its own GameEngine (and therefore its own
+ * GameWorld and Player). A single epoll loop performs non-blocking reads
+ * and writes and splits the byte stream into lines; the turns themselves run
+ * on a TurnScheduler so a slow turn never stalls other players. Each session
+ * has at most one scheduled task at a time, which keeps its turns in order.
+ * A session is a SessionTask coroutine that co_awaits its next line, so an
+ * idle player costs a parked coroutine frame rather than a thread.
+ * Every response ends with the "> " prompt.
+ *
+ * All sessions read their location and item text from one ContentStore;
+ * requestReload() republishes it from disk while players stay connected.
+ */
+class GameServer {
+ public:
+    /**
+     * @brief Listening configuration for the server
+     */
+    struct Options {
+        std::string unixPath;            ///< Unix-domain socket path, empty to disable
+        int tcpPort = 0;                 ///< Localhost TCP port, 0 to disable
+        size_t maxLineLength = 4096;     ///< Longest accepted input line in bytes
+        size_t workerThreads = 0;        ///< Turn worker threads, 0 for one per hardware thread
+        ContentStore* content = nullptr; ///< World text shared by all sessions, nullptr for built-in only
+        std::string contentPath;         ///< File republished into content by requestReload()
+    };
+
+    /**
+     * @brief Constructor for GameServer
+     * @param options Listening configuration
+     * @throws std::runtime_error if no listener could be created
+     */
+    explicit GameServer(const Options& options);
+
+    /**
+     * @brief Destructor, closes all sockets
+     */
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    /**
+     * @brief Run the event loop until stop() is called
+     */
+    void run();
+
+    /**
+     * @brief Ask the event loop to exit
+     *
+     * Safe to call from other threads and from signal handlers.
+     */
+    void stop();
+
+    /**
+     * @brief Ask the event loop to republish world content from contentPath
+     *
+     * Sessions pick up the new text on their next turn. A file that fails to
+     * parse is reported and the current content stays published. Safe to
+     * call from other threads and from signal handlers.
+     */
+    void requestReload();
+
+    /**
+     * @brief Get the number of connected sessions
+     * @return Number of open sessions
+     */
+    size_t getSessionCount() const { return sessions_.size(); }
+
+ private:
+    /**
+     * @brief A framed input line waiting for its turn
+     */
+    struct PendingLine {
+        std::string text;  ///< The line without its terminator
+        bool tooLong;      ///< The line exceeded maxLineLength and was dropped
+    };
+
+    /**
+     * @brief State of one connected player
+     *
+     * Fields marked "loop" are only touched by the event loop thread. Fields
+     * marked "task" are only touched by the session's single in-flight task.
+     * All other fields are guarded by mutex.
+     */
+    struct Session {
+        int fd;                              ///< Connection socket, -1 once closed (loop)
+        std::string received;                ///< Bytes not yet framed into lines (loop)
+        bool discarding;                     ///< Dropping the rest of an overlong line (loop)
+        GameEngine engine;                   ///< The player's private game (task)
+        LineInput lines;                     ///< Feeds lines to the coroutine (task)
+        SessionTask play;                    ///< The session coroutine (task)
+        bool started;                        ///< The coroutine has been started (task)
+
+        std::mutex mutex;                    ///< Guards the fields below
+        std::deque<PendingLine> pending;     ///< Framed lines waiting for a turn
+        std::string output;                  ///< Bytes waiting to be written
+        size_t outputOffset;                 ///< Number of bytes of output already written
+        bool scheduled;                      ///< A turn for this session is queued, or a task is running
+        bool quit;                           ///< The player quit; close after flushing
+        bool peerClosed;                     ///< The peer stopped sending; close after answering
+
+        explicit Session(int socket)
+            : fd(socket), discarding(false), started(false), outputOffset(0),
+              scheduled(false), quit(false), peerClosed(false) {}
+    };
+
+    using SessionPtr = std::shared_ptr<Session>;
+
+    Options options_;                                ///< Listening configuration
+    int epollFd_;                                    ///< epoll instance
+    int wakeFd_;                                     ///< eventfd waking the loop
+    int unixListenFd_;                               ///< Unix-domain listener
+    int tcpListenFd_;                                ///< TCP listener
+    std::atomic<bool> stopRequested_;                ///< Set by stop()
+    std::atomic<bool> reloadRequested_;              ///< Set by requestReload()
+    std::unordered_map<int, SessionPtr> sessions_;   ///< Sessions by socket (loop)
+
+    std::mutex readyMutex_;                          ///< Guards ready_
+    std::vector<SessionPtr> ready_;                  ///< Sessions with fresh output from workers
+
+    std::unique_ptr<TurnScheduler> scheduler_;       ///< Runs the turns
+
+    /**
+     * @brief Create the Unix-domain listening socket
+     */
+    void listenUnix();
+
+    /**
+     * @brief Create the localhost TCP listening socket
+     */
+    void listenTcp();
+
+    /**
+     * @brief Load contentPath and publish it to every session
+     */
+    void reloadContent();
+
+    /**
+     * @brief Accept every pending connection on a listener
+     * @param listenFd The listening socket
+     */
+    void acceptConnections(int listenFd);
+
+    /**
+     * @brief Read available bytes and queue complete lines
+     * @param session The session whose socket is readable
+     */
+    void handleReadable(const SessionPtr& session);
+
+    /**
+     * @brief Queue a task for the session unless one is already in flight
+     * @param session The session to schedule
+     */
+    void schedule(const SessionPtr& session);
+
+    /**
+     * @brief Worker task: run a bounded number of the session's queued turns
+     * @param session The session to run
+     */
+    void runSession(const SessionPtr& session);
+
+    /**
+     * @brief Let an idle worker prerender a waiting session's next views
+     *
+     * The queued task takes the session's scheduled slot only when it
+     * starts, and skips the work if a turn got there first, so a busy
+     * server never holds back a waiting player's next line. Hands over to
+     * runSession() if lines arrived while it ran.
+     *
+     * @param session A session that has just run out of input
+     */
+    void prerender(const SessionPtr& session);
+
+    /**
+     * @brief Session coroutine: play turns as lines arrive until the player quits
+     * @param session The session to play
+     * @return The coroutine, suspended before its first instruction
+     */
+    SessionTask playSession(Session& session);
+
+    /**
+     * @brief Append text produced by a session to its pending output
+     * @param session The session that produced the text
+     * @param text The text to send
+     * @param prompt true to follow the text with a prompt, false if the player quit
+     */
+    static void emit(Session& session, std::string_view text, bool prompt);
+
+    /**
+     * @brief Hand a session with new output back to the event loop
+     * @param session The session to flush
+     */
+    void notifyReady(const SessionPtr& session);
+
+    /**
+     * @brief Flush every session reported by the workers
+     */
+    void drainReady();
+
+    /**
+     * @brief Write as much pending output as the socket accepts
+     * @param session The session to flush
+     */
+    void flushOutput(Session& session);
+
+    /**
+     * @brief Close the session if it is finished, otherwise refresh its interest set
+     * @param session The session to check
+     */
+    void finishEvent(const SessionPtr& session);
+
+    /**
+     * @brief Close a session's socket and forget it
+     *
+     * The game itself is destroyed once no in-flight task holds the session.
+     *
+     * @param session The session to close
+     */
+    void closeSession(Session& session);
+};
+
+#endif  // GAME_SERVER_H_
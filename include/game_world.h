@@ -2,21 +2,34 @@
 #define GAME_WORLD_H_
 
 #include "location_grid.h"
+#include "location_store.h"
 #include "environment_type.h"
+#include "procedural_region.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
 /**
  * @class GameWorld
  * @brief GameWorld supporting grid-based environments
+ *
+ * Environments are built when first needed rather than all at once: the
+ * starting village when the world is created, any other environment when
+ * the player stands at the end of an exit leading into it, when something
+ * asks for it by index, or when prefetch() reaches ahead of the player.
+ * Environments a session never comes near cost nothing.
  */
 class GameWorld {
  public:
+    static constexpr uint64_t kDefaultSeed = 0x456c646f726961;  ///< Seed of the procedural regions by default
+
     /**
      * @brief Constructor for GameWorld
+     * @param seed Seed of the procedural regions; equal seeds give equal worlds
      */
-    GameWorld();
+    explicit GameWorld(uint64_t seed = kDefaultSeed);
 
     /**
      * @brief Initialize the game world
@@ -44,18 +57,111 @@ class GameWorld {
 
     /**
      * @brief Get the coordinates of a location within its grid
+     *
+     * Looks the location up in the placement index of the LocationStore, so
+     * this takes constant time whatever the size of the grids.
+     *
      * @param location The location to find
-     * @return Optional pair of coordinates, empty if not found
+     * @return Optional pair of coordinates, empty if the location is not
+     *         part of this world's grids
      */
     std::optional<std::pair<int, int>> getLocationCoordinates(const Location* location) const;
 
+    /**
+     * @brief Get the number of environments in the world, built or not
+     * @return Number of environments
+     */
+    size_t getEnvironmentCount() const { return types_.size(); }
+
+    /**
+     * @brief Get the number of environments built so far
+     * @return Number of built environments
+     */
+    size_t getBuiltEnvironmentCount() const { return builtCount_; }
+
+    /**
+     * @brief Get a counter of changes to the locations of the world
+     *
+     * Changes whenever locations are created, destroyed or linked: when an
+     * environment is built, and when a procedural region generates or
+     * evicts chunks as the player walks.
+     *
+     * @return The layout version of the LocationStore
+     */
+    uint64_t getLayoutVersion() const { return locations_.getLayoutVersion(); }
+
+    /**
+     * @brief Get an environment by index, building it if needed
+     * @param index Index of the environment, in creation order
+     * @return Pointer to the environment, nullptr if the index is invalid
+     */
+    LocationGrid* getEnvironment(size_t index);
+
+    /**
+     * @brief Get an environment by index without building it
+     * @param index Index of the environment, in creation order
+     * @return Pointer to the environment, nullptr if the index is invalid
+     *         or the environment was not built yet
+     */
+    LocationGrid* findEnvironment(size_t index) const;
+
+    /**
+     * @brief Get a location of a given environment
+     *
+     * Cells of procedural regions are generated if they are not
+     * materialized, so this is the lookup to use for stored coordinates.
+     *
+     * @param index Index of the environment
+     * @param x X coordinate within the environment
+     * @param y Y coordinate within the environment
+     * @return The location, nullptr if there is none
+     */
+    Location* getLocation(size_t index, int x, int y);
+
+    /**
+     * @brief Place the player at a location in a given environment
+     * @param index Index of the environment
+     * @param x X coordinate within the environment
+     * @param y Y coordinate within the environment
+     * @return true if the location exists
+     */
+    bool setCurrentLocation(size_t index, int x, int y);
+
+    /**
+     * @brief Build the environments adjacent to the current one
+     *
+     * Meant for idle time between turns, so that walking into a new
+     * environment finds it already built.
+     *
+     * @return true if an environment was built, adding exits to the world
+     */
+    bool prefetch();
+
  private:
-    std::vector<std::unique_ptr<LocationGrid>> environments_;  ///< All environment grids
+    /**
+     * @brief Exit pair between two environments, linked once both are built
+     */
+    struct Connection {
+        size_t from;  ///< Environment whose cell gets the north exit
+        int fromX;    ///< X coordinate of that cell
+        int fromY;    ///< Y coordinate of that cell
+        size_t to;    ///< Environment whose cell gets the south exit back
+        int toX;      ///< X coordinate of that cell
+        int toY;      ///< Y coordinate of that cell
+    };
+
+    LocationStore locations_;                                  ///< Every location of every environment
+    std::vector<EnvironmentType> types_;                       ///< Type of each environment, by index
+    std::vector<std::unique_ptr<LocationGrid>> environments_;  ///< Environment grids, nullptr until built
+    std::vector<Connection> connections_;                      ///< Exits between environments
+    std::vector<std::unique_ptr<ProceduralRegion>> regions_;   ///< Generators of the procedural environments
+    uint64_t seed_;                                            ///< Seed of the procedural regions
+    size_t builtCount_;                                        ///< Number of environments built
     LocationGrid* currentEnvironment_;                         ///< Current environment
     Location* currentLocation_;                                ///< Current location within environment
 
     /**
-     * @brief Create all game environments
+     * @brief Declare all game environments and their connections
      */
     void createEnvironments();
 
@@ -66,15 +172,59 @@ class GameWorld {
      */
     std::unique_ptr<LocationGrid> createEnvironment(EnvironmentType type);
 
+    /**
+     * @brief Find the generator of a procedural environment
+     * @param environment The environment
+     * @return Its region, nullptr if the environment is handcrafted
+     */
+    ProceduralRegion* findRegion(const LocationGrid* environment) const;
+
+    /**
+     * @brief Build an environment and link its connections to built ones
+     * @param index Index of an environment not built yet
+     */
+    void buildEnvironment(size_t index);
+
+    /**
+     * @brief Build the environments that exits from a cell lead into
+     * @param index Index of the cell's environment
+     * @param x X coordinate of the cell
+     * @param y Y coordinate of the cell
+     */
+    void buildConnectionsAt(size_t index, int x, int y);
+
+    /**
+     * @brief Get the index of a built environment
+     * @param environment The environment
+     * @return Its index, getEnvironmentCount() if it is not part of the world
+     */
+    size_t indexOf(const LocationGrid* environment) const;
+
+    /**
+     * @brief Get the cell at one end of a connection
+     * @param index Index of a built environment
+     * @param x X coordinate of the cell
+     * @param y Y coordinate of the cell
+     * @return The location, nullptr if there is none
+     */
+    Location* findEndpoint(size_t index, int x, int y) const;
+
     /**
      * @brief Connect two environments
      * @param env1 First environment
-     * @param exit1 Exit location in first environment
+     * @param x1 X coordinate of the exit location in the first environment
+     * @param y1 Y coordinate of the exit location in the first environment
      * @param env2 Second environment
-     * @param exit2 Exit location in second environment
+     * @param x2 X coordinate of the exit location in the second environment
+     * @param y2 Y coordinate of the exit location in the second environment
+     */
+    void connectEnvironments(size_t env1, int x1, int y1, size_t env2, int x2, int y2);
+
+    /**
+     * @brief Add the exits of a connection whose environments are both built
+     * @param connection The connection
      */
-    void connectEnvironments(LocationGrid* env1, Location* exit1,
-                           LocationGrid* env2, Location* exit2);
+    void linkConnection(const Connection& connection);
 };
 
 #endif
\ No newline at end of file
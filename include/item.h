@@ -33,6 +33,12 @@ class Item : public Entity {
      */
     std::string GetItemId() const;
 
+    /**
+     * @brief Get the interned identifier of the item
+     * @return The symbol of the item's ID
+     */
+    Symbol GetItemSymbol() const;
+
     /**
      * @brief Attempt to pick up the item
      * @return true if the item was successfully picked up
@@ -65,6 +71,7 @@ class Item : public Entity {
 
  private:
     std::string item_id_;           ///< Unique identifier for the item
+    Symbol item_symbol_;            ///< Interned item_id_
     Location* current_location_;    ///< Current location of the item
 };
 
@@ -3,21 +3,33 @@
 #define LOCATION_H_
 
 #include "entity.h"
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
-#include <unordered_map>
+#include <memory_resource>
 
 class Item;
 class NPC;
 class Puzzle;
+class LocationStore;
+
+/**
+ * @brief Index of a location within its LocationStore
+ */
+using LocationId = std::uint32_t;
+
+constexpr LocationId kNoLocation = UINT32_MAX;  ///< ID of a location outside any store
 
 /**
  * @class Location
  * @brief Represents a single location in the game world
  * 
  * Locations are connected to other locations through exits in cardinal directions,
- * can contain items and NPCs, and may have associated puzzles.
+ * can contain items and NPCs, and may have associated puzzles. Exits are kept
+ * by the LocationStore that created the location; a location built on its own
+ * has none.
  */
 class Location {
  public:
@@ -32,28 +44,34 @@ class Location {
     };
 
     /**
-     * @brief Constructor for Location
+     * @brief Constructor for a Location outside any store
      * @param name The name of the location
      * @param description A detailed description of the location
      */
     Location(const std::string& name, const std::string& description);
 
+    /**
+     * @brief Get the location's ID within its store
+     * @return The ID, kNoLocation if the location is not in a store
+     */
+    LocationId getId() const { return id_; }
+
     /**
      * @brief Get the location's name
      * @return The name of the location
      */
-    std::string getName() const { return name_; }
+    const std::string& getName() const { return name_; }
 
     /**
      * @brief Get the location's description
      * @return The description of the location
      */
-    std::string getDescription() const { return description_; }
+    const std::string& getDescription() const { return description_; }
 
     /**
      * @brief Add an exit to another location
      * @param direction The direction of the exit
-     * @param location Pointer to the connected location
+     * @param location Pointer to the connected location, from the same store
      * @return true if exit was added successfully
      */
     bool addExit(Direction direction, Location* location);
@@ -65,6 +83,13 @@ class Location {
      */
     Location* getExit(Direction direction) const;
 
+    /**
+     * @brief Check for an exit without looking at the room behind it
+     * @param direction The direction to check
+     * @return true if an exit exists in that direction
+     */
+    bool hasExit(Direction direction) const;
+
     /**
      * @brief Add an item to the location
      * @param item Shared pointer to the item to add
@@ -73,10 +98,31 @@ class Location {
 
     /**
      * @brief Remove an item from the location
-     * @param itemName Name of the item to remove
+     * @param itemName Name of the item to remove, in any case
+     * @return Shared pointer to the removed item, nullptr if not found
+     */
+    std::shared_ptr<Item> removeItem(std::string_view itemName);
+
+    /**
+     * @brief Remove an item from the location
+     * @param name The symbol of the item's name
      * @return Shared pointer to the removed item, nullptr if not found
      */
-    std::shared_ptr<Item> removeItem(const std::string& itemName);
+    std::shared_ptr<Item> removeItem(Symbol name);
+
+    /**
+     * @brief Find an item in the location
+     * @param name The symbol of the item's name
+     * @return Shared pointer to the item, nullptr if not found
+     */
+    std::shared_ptr<Item> getItem(Symbol name) const;
+
+    /**
+     * @brief Find an NPC in the location
+     * @param name The symbol of the NPC's name
+     * @return Shared pointer to the NPC, nullptr if not found
+     */
+    std::shared_ptr<NPC> getNPC(Symbol name) const;
 
     /**
      * @brief Add an NPC to the location
@@ -110,14 +156,28 @@ class Location {
 
     /**
      * @brief Generate a detailed description of the location including items and NPCs
+     * @param memory Resource the text is allocated from, such as a per-turn arena
      * @return String containing the full description
      */
-    std::string getFullDescription() const;
+    std::pmr::string getFullDescription(
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource()) const;
 
  private:
+    friend class LocationStore;
+
+    /**
+     * @brief Constructor used by LocationStore::create()
+     * @param store The store that owns the location and its exits
+     * @param id The ID of the location within the store
+     * @param name The name of the location
+     * @param description A detailed description of the location
+     */
+    Location(LocationStore& store, LocationId id, const std::string& name, const std::string& description);
+
+    LocationStore* store_;                   ///< Store holding the exits, nullptr if none
+    LocationId id_;                          ///< Index within store_
     std::string name_;                       ///< Name of the location
     std::string description_;                ///< Description of the location
-    std::unordered_map<Direction, Location*> exits_;  ///< Map of exits to other locations
     std::vector<std::shared_ptr<Item>> items_;        ///< Items in the location
     std::vector<std::shared_ptr<NPC>> npcs_;          ///< NPCs in the location
     std::shared_ptr<Puzzle> puzzle_;                  ///< Associated puzzle
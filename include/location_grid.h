@@ -3,41 +3,53 @@
 
 #include "location.h"
 #include <array>
+#include <cstdint>
 #include <memory>
-#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 /**
  * @class LocationGrid
- * @brief Represents a 3x3 grid of locations within an environment
- * 
- * This class implements the grid-based location system required by the
- * game design, where each environment consists of a 3x3 grid of
- * interconnected locations.
+ * @brief Represents a rectangular grid of locations within an environment
+ *
+ * The built-in environments are 3x3 grids as required by the game design,
+ * but a grid may be anything up to MAX_SIZE on a side. Cells are stored in
+ * CHUNK_SIZE x CHUNK_SIZE chunks that are only allocated once a location is
+ * placed in them, so memory follows the populated area rather than the
+ * bounds. Within a chunk cells are laid out along a Z-order curve, keeping
+ * the four neighbours of a cell close in memory, and chunks are found by
+ * the Z-order code of their position.
  */
 class LocationGrid {
  public:
-    static const int GRID_SIZE = 3;  ///< Size of the grid (3x3)
+    static constexpr int GRID_SIZE = 3;     ///< Size of the built-in environments (3x3)
+    static constexpr int MAX_SIZE = 4096;   ///< Largest width or height of a grid
+    static constexpr int CHUNK_SIZE = 8;    ///< Width and height of a storage chunk
 
     /**
      * @brief Constructor for LocationGrid
      * @param name Name of the environment this grid represents
+     * @param width Number of columns, 1 to MAX_SIZE
+     * @param height Number of rows, 1 to MAX_SIZE
+     * @throws std::invalid_argument if either size is out of range
      */
-    explicit LocationGrid(const std::string& name);
+    explicit LocationGrid(const std::string& name, int width = GRID_SIZE, int height = GRID_SIZE);
 
     /**
      * @brief Set a location in the grid
-     * @param x X coordinate (0-2)
-     * @param y Y coordinate (0-2)
-     * @param location The location to place
+     * @param x X coordinate (0 to width - 1)
+     * @param y Y coordinate (0 to height - 1)
+     * @param location The location to place, owned by the world's LocationStore
      * @return true if location was set successfully
      */
-    bool setLocation(int x, int y, std::shared_ptr<Location> location);
+    bool setLocation(int x, int y, Location* location);
 
     /**
      * @brief Get a location from the grid
      * @param x X coordinate
      * @param y Y coordinate
-     * @return Pointer to the location, nullptr if invalid coordinates
+     * @return Pointer to the location, nullptr if invalid coordinates or empty cell
      */
     Location* getLocation(int x, int y) const;
 
@@ -47,15 +59,95 @@ class LocationGrid {
      */
     std::string getName() const { return name_; }
 
+    /**
+     * @brief Get the number of columns
+     * @return Grid width
+     */
+    int getWidth() const { return width_; }
+
+    /**
+     * @brief Get the number of rows
+     * @return Grid height
+     */
+    int getHeight() const { return height_; }
+
+    /**
+     * @brief Get the number of chunks allocated so far
+     * @return Chunk count
+     */
+    size_t getChunkCount() const { return chunks_.size(); }
+
+    /**
+     * @brief Visit every populated cell
+     *
+     * Chunks are visited in the order they were allocated and cells in
+     * Z-order within each chunk, so the order is the same for grids built
+     * the same way.
+     *
+     * @param visit Called as visit(x, y, location) for each populated cell
+     */
+    template <typename Visit>
+    void forEachLocation(Visit&& visit) const {
+        for (const auto& chunk : chunks_) {
+            for (uint32_t cell = 0; cell < kChunkCells; ++cell) {
+                if (Location* location = chunk->cells[cell]) {
+                    visit(chunk->originX + static_cast<int>(compact(cell)),
+                          chunk->originY + static_cast<int>(compact(cell >> 1)),
+                          location);
+                }
+            }
+        }
+    }
+
     /**
      * @brief Connect this grid's locations internally
-     * Sets up connections between adjacent locations in the grid
+     *
+     * Sets up connections between adjacent locations in the grid. Runs in
+     * time linear in the number of chunks: each chunk looks up its east and
+     * south neighbours once.
      */
     void connectGridLocations();
 
+    /**
+     * @brief Connect the locations of one chunk to each other and to the
+     *        chunks around it
+     *
+     * Used when chunks are filled one at a time, as the procedural regions do.
+     *
+     * @param chunkX Column of the chunk (x / CHUNK_SIZE)
+     * @param chunkY Row of the chunk (y / CHUNK_SIZE)
+     */
+    void connectChunk(int chunkX, int chunkY);
+
+    /**
+     * @brief Forget a chunk and all the cells in it
+     *
+     * The locations themselves belong to the LocationStore; the caller
+     * destroys them.
+     *
+     * @param chunkX Column of the chunk
+     * @param chunkY Row of the chunk
+     * @return true if the chunk was allocated
+     */
+    bool releaseChunk(int chunkX, int chunkY);
+
  private:
+    static constexpr uint32_t kChunkCells = CHUNK_SIZE * CHUNK_SIZE;  ///< Cells per chunk
+
+    /**
+     * @brief A CHUNK_SIZE x CHUNK_SIZE block of cells in Z-order
+     */
+    struct Chunk {
+        int originX;                                ///< X coordinate of the chunk's first cell
+        int originY;                                ///< Y coordinate of the chunk's first cell
+        std::array<Location*, kChunkCells> cells;   ///< Cells, indexed by interleave(x, y) within the chunk
+    };
+
     std::string name_;  ///< Name of this environment
-    std::array<std::array<std::shared_ptr<Location>, GRID_SIZE>, GRID_SIZE> grid_;  ///< The 3x3 grid
+    int width_;         ///< Number of columns
+    int height_;        ///< Number of rows
+    std::vector<std::unique_ptr<Chunk>> chunks_;        ///< Allocated chunks, in allocation order
+    std::unordered_map<uint32_t, Chunk*> directory_;    ///< Chunks by Z-order code of their position
 
     /**
      * @brief Validate grid coordinates
@@ -64,6 +156,44 @@ class LocationGrid {
      * @return true if coordinates are valid
      */
     bool isValidCoordinate(int x, int y) const;
+
+    /**
+     * @brief Find the chunk at a chunk position
+     * @param chunkX Column of the chunk
+     * @param chunkY Row of the chunk
+     * @return The chunk, nullptr if it was never allocated
+     */
+    Chunk* findChunk(int chunkX, int chunkY) const;
+
+    /**
+     * @brief Connect two cells with a pair of opposite exits
+     * @param from First cell, nullptr to do nothing
+     * @param direction Direction from the first cell to the second
+     * @param to Second cell, nullptr to do nothing
+     */
+    static void link(Location* from, Location::Direction direction, Location* to);
+
+    /**
+     * @brief Interleave the bits of two coordinates into a Z-order code
+     * @param x Coordinate in the even bits, below 2^16
+     * @param y Coordinate in the odd bits, below 2^16
+     * @return The Z-order code
+     */
+    static uint32_t interleave(uint32_t x, uint32_t y) { return spread(x) | (spread(y) << 1); }
+
+    /**
+     * @brief Move the low 16 bits of a value to the even bits
+     * @param value Value to spread
+     * @return The spread value
+     */
+    static uint32_t spread(uint32_t value);
+
+    /**
+     * @brief Gather the even bits of a value into its low 16 bits
+     * @param value Value to compact; the inverse of spread()
+     * @return The compacted value
+     */
+    static uint32_t compact(uint32_t value);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,152 @@
+#ifndef LOCATION_STORE_H_
+#define LOCATION_STORE_H_
+
+#include "location.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class LocationGrid;
+
+/**
+ * @class LocationStore
+ * @brief Owns every location of a world, with the exit graph kept apart
+ *
+ * The store is laid out as parallel arrays indexed by LocationId. The exit
+ * graph, which movement and every walk of the map read, is one array of
+ * four fixed slots per room: 16 bytes, so four rooms share a cache line
+ * and following an exit never touches names, descriptions or contents.
+ * That cold data lives in the Location objects, which are allocated once
+ * and never move, so Location pointers handed out stay valid until the
+ * location is destroyed. A third array records which grid cell each room
+ * was placed in, so a location's environment and coordinates are a single
+ * index away.
+ */
+class LocationStore {
+ public:
+    /**
+     * @brief Exit slots of one room, indexed by Location::Direction
+     */
+    using Exits = std::array<LocationId, 4>;
+
+    /**
+     * @brief Grid cell a room was placed in
+     */
+    struct Placement {
+        LocationGrid* environment = nullptr;  ///< Grid holding the room, nullptr if never placed
+        int x = 0;                            ///< Column within the grid
+        int y = 0;                            ///< Row within the grid
+    };
+
+    LocationStore() = default;
+
+    LocationStore(const LocationStore&) = delete;
+    LocationStore& operator=(const LocationStore&) = delete;
+
+    /**
+     * @brief Create a location with no exits
+     * @param name The name of the location
+     * @param description A detailed description of the location
+     * @return The new location, owned by the store
+     */
+    Location* create(const std::string& name, const std::string& description);
+
+    /**
+     * @brief Destroy a location and free its ID for reuse
+     *
+     * Exits of its neighbours that lead back to it are removed. Rooms with
+     * a one-way exit into it must not outlive it.
+     *
+     * @param id The ID of the location
+     * @return true if a location was destroyed
+     */
+    bool destroy(LocationId id);
+
+    /**
+     * @brief Get a location by ID
+     * @param id The ID of the location
+     * @return The location, nullptr if the ID is kNoLocation, unknown or freed
+     */
+    Location* get(LocationId id) const {
+        return id < rooms_.size() ? rooms_[id].get() : nullptr;
+    }
+
+    /**
+     * @brief Get the exit slots of a location
+     * @param id The ID of the location; must be valid
+     * @return The IDs of its neighbours, kNoLocation where there is no exit
+     */
+    const Exits& getExits(LocationId id) const { return exits_[id]; }
+
+    /**
+     * @brief Get the ID of the location beyond an exit
+     * @param id The ID of the location; must be valid
+     * @param direction The direction of the exit
+     * @return The neighbour's ID, kNoLocation if there is no exit
+     */
+    LocationId getExit(LocationId id, Location::Direction direction) const {
+        return exits_[id][static_cast<size_t>(direction)];
+    }
+
+    /**
+     * @brief Add a one-way exit between two locations
+     * @param from The ID of the location the exit leaves
+     * @param direction The direction of the exit
+     * @param to The ID of the location it leads to
+     * @return true if the exit was added, false if either ID is invalid or freed
+     *         or the slot is already taken
+     */
+    bool link(LocationId from, Location::Direction direction, LocationId to);
+
+    /**
+     * @brief Record the grid cell a location was placed in
+     * @param id The ID of the location; must be valid
+     * @param environment The grid holding it
+     * @param x Column within the grid
+     * @param y Row within the grid
+     */
+    void setPlacement(LocationId id, LocationGrid* environment, int x, int y) {
+        placements_[id] = Placement{environment, x, y};
+    }
+
+    /**
+     * @brief Get the grid cell a location was placed in
+     * @param id The ID of the location; must be valid
+     * @return Its placement; environment is nullptr if it was never placed
+     */
+    const Placement& getPlacement(LocationId id) const { return placements_[id]; }
+
+    /**
+     * @brief Get the number of IDs handed out so far
+     * @return ID count; IDs run from 0 to size() - 1, some possibly freed
+     */
+    size_t size() const { return rooms_.size(); }
+
+    /**
+     * @brief Get the number of locations alive in the store
+     * @return size() less the IDs freed by destroy() and not yet reused
+     */
+    size_t getLiveCount() const { return rooms_.size() - freeIds_.size(); }
+
+    /**
+     * @brief Get a counter of changes to the set of rooms and their exits
+     *
+     * Bumped by create(), destroy() and link(). A destroyed room's address
+     * may be handed to the next room created, so anything keyed by Location
+     * pointers is only valid while this stays the same.
+     *
+     * @return The layout version
+     */
+    uint64_t getLayoutVersion() const { return layoutVersion_; }
+
+ private:
+    std::vector<Exits> exits_;                       ///< Hot: exit slots per room
+    std::vector<std::unique_ptr<Location>> rooms_;   ///< Cold: text, contents and puzzle per room
+    std::vector<Placement> placements_;              ///< Grid cell of each room, for reverse lookups
+    std::vector<LocationId> freeIds_;                ///< IDs freed by destroy(), reused first
+    uint64_t layoutVersion_ = 0;                     ///< Rooms created, destroyed or linked so far
+};
+
+#endif
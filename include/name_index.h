@@ -0,0 +1,178 @@
+#ifndef NAME_INDEX_H_
+#define NAME_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class NameIndex
+ * @brief Trie of names for abbreviation and typo-tolerant lookup
+ *
+ * Every name is indexed under each of its words, so "scr" finds
+ * "Quest Scroll" as well as "qu" does. Lookups are case-insensitive and
+ * expect lowercase input, which is what CommandParser produces.
+ *
+ * Names are reference counted: inserting the same name twice (two items
+ * with one name, or an item seen both here and in the inventory) needs two
+ * erases to remove it. Inserting and erasing touch only the name's own
+ * keys, so the index can follow the game turn by turn without rebuilds.
+ */
+class NameIndex {
+ public:
+    /**
+     * @brief Constructor for NameIndex, starts empty
+     */
+    NameIndex();
+
+    /**
+     * @brief Add a reference to a name
+     * @param name The name, in its display case
+     */
+    void insert(std::string_view name);
+
+    /**
+     * @brief Drop a reference to a name, removing it with the last one
+     * @param name The name, in any case
+     */
+    void erase(std::string_view name);
+
+    /**
+     * @brief Remove every name
+     */
+    void clear();
+
+    /**
+     * @brief Find the name a player most likely meant by a prefix
+     *
+     * A name equal to the text wins; otherwise the text must be the start of
+     * words of exactly one name.
+     *
+     * @param text Lowercase text typed by the player
+     * @param memory Resource for scratch space, such as a per-turn arena
+     * @return The name in display case, empty if none or ambiguous
+     */
+    std::string_view resolve(std::string_view text,
+                             std::pmr::memory_resource* memory = std::pmr::get_default_resource()) const;
+
+    /**
+     * @brief Find the name closest to a misspelling
+     * @param text Lowercase text typed by the player
+     * @param maxDistance Largest edit distance accepted
+     * @param memory Resource for scratch space, such as a per-turn arena
+     * @return The closest name in display case, empty if none is close enough
+     */
+    std::string_view suggest(std::string_view text, size_t maxDistance,
+                             std::pmr::memory_resource* memory = std::pmr::get_default_resource()) const;
+
+    /**
+     * @brief List every name a prefix could complete to
+     *
+     * Names that start with the text come first, then names with a later
+     * word that does; each group is in alphabetical order.
+     *
+     * @param text Text typed so far, in any case
+     * @param out Receives the names in display case, appended; they view
+     *        this index and stay valid until it is next modified
+     */
+    void complete(std::string_view text, std::vector<std::string_view>& out) const;
+
+    /**
+     * @brief Get the number of distinct names
+     * @return Name count
+     */
+    size_t size() const { return size_; }
+
+ private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    /**
+     * @brief A trie node
+     */
+    struct Node {
+        std::vector<std::pair<char, uint32_t>> children;  ///< Child nodes by character, sorted
+        std::vector<uint32_t> names;                      ///< Names whose key ends here
+    };
+
+    /**
+     * @brief An indexed name
+     */
+    struct Name {
+        std::string display;  ///< Name as shown to the player, empty when the entry is free
+        std::string lower;    ///< Lowercase name the keys are taken from
+        size_t references;    ///< Number of insert() calls not yet erased
+    };
+
+    std::vector<Node> nodes_;      ///< Trie nodes, root first
+    std::vector<Name> names_;      ///< Names by id
+    std::vector<uint32_t> free_;   ///< Ids of free entries in names_
+    size_t size_;                  ///< Number of live names
+
+    /**
+     * @brief Find a name's id
+     * @param name The name, in any case
+     * @return The id, kNone if the name is not indexed
+     */
+    uint32_t findName(std::string_view name) const;
+
+    /**
+     * @brief Get the node reached by a key, adding missing nodes
+     * @param key Lowercase key
+     * @return The node index
+     */
+    uint32_t walk(std::string_view key);
+
+    /**
+     * @brief Get the node reached by a key without modifying the trie
+     * @param key The key, in any case
+     * @return The node index, kNone if missing
+     */
+    uint32_t find(std::string_view key) const;
+
+    /**
+     * @brief Collect up to two distinct names under a node
+     * @param node Subtree root
+     * @param found Names found so far
+     */
+    void collect(uint32_t node, std::pmr::vector<uint32_t>& found) const;
+
+    /**
+     * @brief Append every name under a node not already listed
+     * @param node Subtree root
+     * @param out Names found so far
+     * @param first Index in out of the first name of this search
+     */
+    void completeFrom(uint32_t node, std::vector<std::string_view>& out, size_t first) const;
+
+    /**
+     * @brief Edit-distance search below a node
+     * @param node Current node
+     * @param c Character on the edge into node
+     * @param text The misspelled text
+     * @param rows Distance rows by depth; the parent's row is at depth - 1
+     * @param depth Depth of node, the length of its key
+     * @param maxDistance Largest distance accepted
+     * @param best Closest name found so far and its distance
+     */
+    void suggestFrom(uint32_t node, char c, std::string_view text, std::pmr::vector<size_t>& rows,
+                     size_t depth, size_t maxDistance, std::pair<uint32_t, size_t>& best) const;
+
+    /**
+     * @brief Call a function for every key of a name: the name from each word on
+     * @param lower Lowercase name
+     * @param visit Callback taking a std::string_view key
+     */
+    template <typename Visitor>
+    static void forEachKey(std::string_view lower, Visitor visit) {
+        for (size_t start = 0; start < lower.size(); ++start) {
+            if (lower[start] != ' ' && (start == 0 || lower[start - 1] == ' ')) {
+                visit(lower.substr(start));
+            }
+        }
+    }
+};
+
+#endif  // NAME_INDEX_H_
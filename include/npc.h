@@ -189,7 +189,7 @@ private:
     std::unordered_map<DialogueState, std::string> dialogues_;  ///< State-specific dialogues
     std::vector<std::string> hints_;                            ///< Collection of hints
     std::unordered_map<std::string, std::string> keyword_responses_;  ///< Keyword-triggered responses
-    std::unordered_map<std::string, std::string> interaction_items_;  ///< Item interaction responses
+    std::unordered_map<Symbol, std::string> interaction_items_;       ///< Item interaction responses, by interned item ID
 };
 
 #endif  // NPC_H_
\ No newline at end of file
@@ -0,0 +1,107 @@
+#ifndef OUTPUT_BUFFER_H_
+#define OUTPUT_BUFFER_H_
+
+#include <charconv>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @class OutputBuffer
+ * @brief Append-only text buffer with a small stream-like formatter
+ *
+ * Game text is collected here for a whole turn and handed out in one piece,
+ * instead of being streamed token by token into std::cout. Clearing keeps
+ * the allocated capacity, so a buffer reused turn after turn stops
+ * allocating once it has grown to the largest turn.
+ */
+class OutputBuffer {
+ public:
+    OutputBuffer& operator<<(std::string_view text) {
+        data_.append(text);
+        return *this;
+    }
+
+    OutputBuffer& operator<<(const char* text) {
+        data_.append(text);
+        return *this;
+    }
+
+    OutputBuffer& operator<<(char c) {
+        data_.push_back(c);
+        return *this;
+    }
+
+    /**
+     * @brief Append an integer in decimal
+     * @param value The number to append
+     */
+    template <typename Integer,
+              typename = std::enable_if_t<std::is_integral_v<Integer> &&
+                                          !std::is_same_v<Integer, char> &&
+                                          !std::is_same_v<Integer, bool>>>
+    OutputBuffer& operator<<(Integer value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        data_.append(digits, result.ptr);
+        return *this;
+    }
+
+    /**
+     * @brief Append text right-aligned in a field, like std::setw
+     * @param text The text to append
+     * @param width Minimum field width
+     * @return This buffer
+     */
+    OutputBuffer& pad(std::string_view text, size_t width) {
+        if (text.size() < width) {
+            data_.append(width - text.size(), ' ');
+        }
+        data_.append(text);
+        return *this;
+    }
+
+    /**
+     * @brief Append a character several times
+     * @param c The character to append
+     * @param count How many times to append it
+     * @return This buffer
+     */
+    OutputBuffer& repeat(char c, size_t count) {
+        data_.append(count, c);
+        return *this;
+    }
+
+    /**
+     * @brief Get the collected text
+     * @return View of the text, valid until the buffer is next modified
+     */
+    std::string_view view() const { return data_; }
+
+    size_t size() const { return data_.size(); }
+    bool empty() const { return data_.empty(); }
+
+    /**
+     * @brief Discard the text but keep the allocated capacity
+     */
+    void clear() { data_.clear(); }
+
+ private:
+    std::string data_;  ///< Collected text
+};
+
+/**
+ * @brief Write several pieces of text to a file descriptor with writev
+ *
+ * Retries on partial writes and EINTR, so the pieces leave in as few
+ * system calls as the descriptor allows.
+ *
+ * @param fd Destination file descriptor
+ * @param parts Text to write, in order
+ * @return true if everything was written
+ */
+bool writeFully(int fd, std::initializer_list<std::string_view> parts);
+
+#endif  // OUTPUT_BUFFER_H_
@@ -6,8 +6,10 @@
 #include "location.h"
 #include "item.h"
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <string>
+#include <string_view>
 
 /**
  * @class Player
@@ -42,37 +44,66 @@ public:
 
     /**
      * @brief Remove an item from the player's inventory
-     * @param itemId The ID of the item to remove
+     * @param itemId The name of the item to remove, in any case
      * @return true if the item was removed successfully
      */
-    bool removeItem(const std::string &itemId);
+    bool removeItem(std::string_view itemId);
+
+    /**
+     * @brief Remove an item from the player's inventory
+     * @param name The symbol of the item's name
+     * @return true if the item was removed successfully
+     */
+    bool removeItem(Symbol name);
+
+    /**
+     * @brief Get an item from the player's inventory
+     * @param itemId The name of the item to get, in any case
+     * @return Shared pointer to the item, nullptr if not found
+     */
+    std::shared_ptr<Item> getItem(std::string_view itemId) const;
 
     /**
      * @brief Get an item from the player's inventory
-     * @param itemId The ID of the item to get
+     * @param name The symbol of the item's name
      * @return Shared pointer to the item, nullptr if not found
      */
-    std::shared_ptr<Item> getItem(const std::string &itemId) const;
+    std::shared_ptr<Item> getItem(Symbol name) const;
 
     /**
      * @brief Check if player has a specific item
-     * @param itemId The ID of the item to check
+     * @param itemId The name of the item to check, in any case
      * @return true if the player has the item
      */
-    bool hasItem(const std::string &itemId) const;
+    bool hasItem(std::string_view itemId) const;
+
+    /**
+     * @brief Check if player has a specific item
+     * @param name The symbol of the item's name
+     * @return true if the player has the item
+     */
+    bool hasItem(Symbol name) const;
 
     /**
      * @brief Get a description of the player's inventory
+     * @param memory Resource the text is allocated from, such as a per-turn arena
      * @return String containing inventory description
      */
-    std::string getInventoryDescription() const;
+    std::pmr::string getInventoryDescription(
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource()) const;
+
+    /**
+     * @brief Get all items in the player's inventory
+     * @return Vector of items in the order they were picked up
+     */
+    const std::vector<std::shared_ptr<Item>>& getInventory() const { return inventory_; }
 
     /**
      * @brief Use an item from the inventory
      * @param itemId The ID of the item to use
      * @return true if the item was used successfully
      */
-    bool useItem(const std::string &itemId);
+    bool useItem(std::string_view itemId);
 
     /**
      * @brief Set the player's current location
@@ -0,0 +1,125 @@
+#ifndef PROCEDURAL_REGION_H_
+#define PROCEDURAL_REGION_H_
+
+#include "environment_type.h"
+#include "location_grid.h"
+#include "location_store.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ProceduralRegion
+ * @brief Fills a large LocationGrid with generated locations around the player
+ *
+ * Every chunk of the grid is a pure function of the world seed and the
+ * chunk's coordinates, so it can be generated when the player comes near
+ * and thrown away again once the player has moved on. approach() keeps the
+ * chunks within ACTIVE_RADIUS of the player's chunk materialized and evicts
+ * the ones beyond EVICT_RADIUS, unless something in them was changed (an
+ * item dropped, an NPC or puzzle placed) or they were pinned by anchor().
+ * Memory therefore follows the player's surroundings and what they left
+ * behind, not the 4096x4096 extent of the grid.
+ */
+class ProceduralRegion {
+ public:
+    static constexpr int ACTIVE_RADIUS = 1;  ///< Chunks around the player that are always materialized
+    static constexpr int EVICT_RADIUS = 2;   ///< Unchanged chunks further away than this are evicted
+
+    /**
+     * @brief Constructor for ProceduralRegion
+     * @param type The kind of region; must satisfy isProcedural()
+     * @param seed Seed of the world; equal seeds generate equal regions
+     * @param grid The grid to fill, as built by EnvironmentBuilder
+     * @param store Store that owns the generated locations
+     * @throws std::invalid_argument if type is not procedural
+     */
+    ProceduralRegion(EnvironmentType type, uint64_t seed, LocationGrid& grid, LocationStore& store);
+
+    ProceduralRegion(const ProceduralRegion&) = delete;
+    ProceduralRegion& operator=(const ProceduralRegion&) = delete;
+
+    /**
+     * @brief Get the grid this region fills
+     * @return The grid
+     */
+    LocationGrid& getGrid() const { return grid_; }
+
+    /**
+     * @brief Get a location, generating its chunk if needed
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @return The location, nullptr if the coordinates are outside the grid
+     */
+    Location* materialize(int x, int y);
+
+    /**
+     * @brief Get a location whose chunk is never evicted
+     *
+     * Used for the cells that exits from other environments lead into.
+     *
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @return The location, nullptr if the coordinates are outside the grid
+     */
+    Location* anchor(int x, int y);
+
+    /**
+     * @brief Bring the chunks around a cell in and evict the distant ones
+     * @param x X coordinate of the player
+     * @param y Y coordinate of the player
+     */
+    void approach(int x, int y);
+
+    /**
+     * @brief Get the number of chunks currently materialized
+     * @return Chunk count
+     */
+    size_t getResidentChunkCount() const { return resident_.size(); }
+
+ private:
+    /**
+     * @brief A materialized chunk
+     */
+    struct ResidentChunk {
+        int chunkX;   ///< Column of the chunk
+        int chunkY;   ///< Row of the chunk
+        bool pinned;  ///< Whether anchor() exempted it from eviction
+    };
+
+    EnvironmentType type_;                  ///< Kind of region, choosing the terrain
+    uint64_t seed_;                         ///< Seed of the world
+    LocationGrid& grid_;                    ///< Grid being filled
+    LocationStore& store_;                  ///< Owner of the generated locations
+    std::vector<ResidentChunk> resident_;   ///< Materialized chunks
+
+    /**
+     * @brief Find a materialized chunk
+     * @param chunkX Column of the chunk
+     * @param chunkY Row of the chunk
+     * @return Its entry in resident_, nullptr if it is not materialized
+     */
+    ResidentChunk* findResident(int chunkX, int chunkY);
+
+    /**
+     * @brief Generate a chunk and connect it to the chunks around it
+     * @param chunkX Column of the chunk
+     * @param chunkY Row of the chunk
+     * @return Its entry in resident_, nullptr if it lies outside the grid
+     */
+    ResidentChunk* generate(int chunkX, int chunkY);
+
+    /**
+     * @brief Check whether a chunk differs from what generate() makes
+     * @param chunk The chunk
+     * @return true if any location in it holds items, NPCs or a puzzle
+     */
+    bool isModified(const ResidentChunk& chunk) const;
+
+    /**
+     * @brief Destroy the locations of a chunk and release it from the grid
+     * @param chunk The chunk
+     */
+    void evict(const ResidentChunk& chunk);
+};
+
+#endif
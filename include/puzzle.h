@@ -3,6 +3,7 @@
 #define PUZZLE_H_
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <stdexcept>
@@ -60,7 +61,7 @@ class Puzzle {
      * @return true if the puzzle is solved, false otherwise
      * @throws PuzzleException if the puzzle cannot be attempted
      */
-    virtual bool AttemptSolution(const std::string& attempt) = 0;
+    virtual bool AttemptSolution(std::string_view attempt) = 0;
 
     /**
      * @brief Check if the puzzle is solved
@@ -70,9 +71,9 @@ class Puzzle {
 
     /**
      * @brief Get a hint for the puzzle
-     * @return A string containing the hint
+     * @return The hint, valid while the puzzle lives
      */
-    virtual std::string GetHint() const = 0;
+    virtual std::string_view GetHint() const = 0;
 
     /**
      * @brief Check if the puzzle can be attempted
@@ -109,6 +110,19 @@ class Puzzle {
      */
     int GetAttemptsRemaining() const;
 
+    /**
+     * @brief Get the number of attempts made so far
+     * @return Number of attempts made
+     */
+    int GetAttempts() const;
+
+    /**
+     * @brief Restore saved progress
+     * @param state The saved puzzle state
+     * @param attempts The saved number of attempts
+     */
+    void RestoreProgress(PuzzleState state, int attempts);
+
  protected:
     /**
      * @brief Set the puzzle's state
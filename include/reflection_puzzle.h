@@ -16,6 +16,15 @@ struct Mirror {
     bool placed;   ///< Whether the mirror is placed on the grid
 };
 
+/**
+ * @struct PlacedMirror
+ * @brief A mirror together with its position on the grid
+ */
+struct PlacedMirror {
+    int x, y;      ///< Grid position
+    int rotation;  ///< Rotation in degrees
+};
+
 /**
  * @struct LightBeam
  * @brief Represents a beam of light in the puzzle
@@ -57,13 +66,13 @@ class ReflectionPuzzle : public Puzzle {
      * @param attempt Unused in this puzzle type
      * @return true if light beam reaches target
      */
-    bool AttemptSolution(const std::string& attempt) override;
+    bool AttemptSolution(std::string_view attempt) override;
 
     /**
      * @brief Get hint for current puzzle state
      * @return String containing hint
      */
-    std::string GetHint() const override;
+    std::string_view GetHint() const override;
 
     /**
      * @brief Check if puzzle can be attempted
@@ -109,6 +118,18 @@ class ReflectionPuzzle : public Puzzle {
      */
     void SetHasLens(bool has_lens);
 
+    /**
+     * @brief Check if the Crystal Lens is present
+     * @return true if the player has the Crystal Lens
+     */
+    bool HasLens() const;
+
+    /**
+     * @brief Get all mirrors currently on the grid
+     * @return Vector of mirrors in row-major order
+     */
+    std::vector<PlacedMirror> GetMirrors() const;
+
  private:
     using Grid = std::array<std::array<std::optional<Mirror>, GRID_SIZE>, GRID_SIZE>;
 
@@ -36,13 +36,13 @@ class RiddlePuzzle : public Puzzle {
      * @param attempt The attempted answer
      * @return true if the answer is correct
      */
-    bool AttemptSolution(const std::string& attempt) override;
+    bool AttemptSolution(std::string_view attempt) override;
 
     /**
      * @brief Get a hint for the riddle
      * @return The hint string
      */
-    std::string GetHint() const override;
+    std::string_view GetHint() const override;
 
  private:
     std::vector<std::string> correct_answers_;  ///< List of acceptable answers
@@ -54,6 +54,14 @@ class RiddlePuzzle : public Puzzle {
      * @return The normalized string (lowercase, trimmed)
      */
     static std::string NormalizeString(const std::string& str);
+
+    /**
+     * @brief Compare an attempt with a normalized answer without copying it
+     * @param attempt The attempt, in any case and possibly padded
+     * @param answer A normalized answer
+     * @return true if the attempt normalizes to the answer
+     */
+    static bool MatchesAnswer(std::string_view attempt, const std::string& answer);
 };
 
 #endif  // RIDDLE_PUZZLE_H
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef SESSION_TASK_H_
+#define SESSION_TASK_H_
+
+#include <coroutine>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * @class SessionTask
+ * @brief Coroutine type for a conversation with one player
+ *
+ * The coroutine is created suspended and runs when start() is called. It
+ * then runs until it awaits its LineInput, and continues each time a line
+ * is delivered. A suspended task costs only its coroutine frame, so a
+ * process can park a very large number of idle sessions.
+ */
+class SessionTask {
+ public:
+    /**
+     * @brief Coroutine promise required by the language
+     */
+    struct promise_type {
+        std::exception_ptr exception;  ///< Exception that escaped the coroutine body
+
+        SessionTask get_return_object() {
+            return SessionTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+    SessionTask() = default;
+
+    SessionTask(SessionTask&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    SessionTask& operator=(SessionTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    SessionTask(const SessionTask&) = delete;
+    SessionTask& operator=(const SessionTask&) = delete;
+
+    ~SessionTask() { reset(); }
+
+    /**
+     * @brief Run the coroutine up to its first suspension point
+     * @throws Any exception that escaped the coroutine body
+     */
+    void start() {
+        handle_.resume();
+        rethrowIfFailed();
+    }
+
+    /**
+     * @brief Check if the coroutine is alive and has not finished
+     * @return true if the coroutine can still receive input
+     */
+    bool isActive() const { return handle_ && !handle_.done(); }
+
+    /**
+     * @brief Rethrow an exception that escaped the coroutine, once
+     */
+    void rethrowIfFailed() {
+        if (handle_ && handle_.promise().exception) {
+            std::rethrow_exception(std::exchange(handle_.promise().exception, nullptr));
+        }
+    }
+
+    /**
+     * @brief Destroy the coroutine frame
+     */
+    void reset() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+ private:
+    explicit SessionTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;  ///< Owned coroutine frame
+};
+
+/**
+ * @class BasicLineInput
+ * @brief Single-consumer source of input lines for a SessionTask
+ *
+ * A coroutine writes `std::string line = co_await input.next();`; whoever
+ * owns the input later calls deliver(), which resumes the coroutine on the
+ * calling thread until it awaits again or finishes.
+ *
+ * Since the coroutine runs inside deliver(), a Line of std::string_view is
+ * enough when the consumer is done with each line before awaiting the next.
+ *
+ * @tparam Line Type of a line, std::string or std::string_view
+ */
+template <typename Line>
+class BasicLineInput {
+ public:
+    /**
+     * @brief Awaitable returned by next()
+     */
+    class Awaiter {
+     public:
+        explicit Awaiter(BasicLineInput& input) : input_(input) {}
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> waiter) noexcept { input_.waiter_ = waiter; }
+        Line await_resume() { return std::move(input_.line_); }
+
+     private:
+        BasicLineInput& input_;
+    };
+
+    /**
+     * @brief Suspend until the next line is delivered
+     * @return Awaitable producing the line
+     */
+    Awaiter next() { return Awaiter(*this); }
+
+    /**
+     * @brief Check if a coroutine is suspended waiting for a line
+     * @return true if deliver() will resume a coroutine
+     */
+    bool isWaiting() const { return static_cast<bool>(waiter_); }
+
+    /**
+     * @brief Hand a line to the waiting coroutine and resume it
+     * @param line The input line
+     * @return false if no coroutine was waiting
+     */
+    bool deliver(Line line) {
+        if (!waiter_) {
+            return false;
+        }
+        line_ = std::move(line);
+        std::exchange(waiter_, nullptr).resume();
+        return true;
+    }
+
+ private:
+    std::coroutine_handle<> waiter_;  ///< Suspended consumer, if any
+    Line line_;                       ///< Line being handed over
+};
+
+using LineInput = BasicLineInput<std::string>;
+
+#endif  // SESSION_TASK_H_
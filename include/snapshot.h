@@ -0,0 +1,52 @@
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+#include <cstdint>
+#include <string>
+
+class GameWorld;
+class Player;
+
+/**
+ * @class Snapshot
+ * @brief Versioned binary save format for one game session
+ *
+ * A snapshot records where every item is (a location or the player's
+ * inventory), each NPC's dialogue and quest state, every puzzle's progress
+ * including reflection mirrors and book arrangements, and the player's
+ * current location. The file is a header followed by fixed-size records
+ * and a string table, so a restore maps the file and reads the records in
+ * place; the only text involved is item and book IDs looked up in a map.
+ *
+ * Snapshots describe changes relative to the world EnvironmentBuilder
+ * creates, so they are applied to a freshly built world.
+ */
+class Snapshot {
+ public:
+    static constexpr uint32_t kVersion = 3;  ///< Current format version
+
+    /**
+     * @brief Write a snapshot of a session to a file
+     *
+     * Writes to a temporary file first and renames it into place, so a
+     * crash never leaves a half-written snapshot behind.
+     *
+     * @param world The session's world
+     * @param player The session's player
+     * @param path Destination file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void save(const GameWorld& world, const Player& player, const std::string& path);
+
+    /**
+     * @brief Restore a snapshot into a freshly built session
+     * @param world A world as built by GameWorld's constructor
+     * @param player A player with the default inventory
+     * @param path Snapshot file to read
+     * @throws std::runtime_error if the file is missing, from another
+     *         version, or does not match the world
+     */
+    static void load(GameWorld& world, Player& player, const std::string& path);
+};
+
+#endif  // SNAPSHOT_H_
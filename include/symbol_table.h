@@ -0,0 +1,130 @@
+#ifndef SYMBOL_TABLE_H_
+#define SYMBOL_TABLE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Integer ID of an interned name; equal IDs mean equal names
+ */
+using Symbol = std::uint32_t;
+
+constexpr Symbol kNoSymbol = 0;  ///< ID of a name that was never interned
+
+/**
+ * @class SymbolTable
+ * @brief Maps entity names and item IDs to small integers
+ *
+ * Names are interned once, when the entities that carry them are built, so
+ * that matching a noun against the items of a room or an inventory is an
+ * integer compare. Interning ignores ASCII case: "Quest Scroll" and
+ * "quest scroll" are the same symbol, just as player input is matched.
+ *
+ * Symbols are never removed. The process-wide table returned by global()
+ * is shared by every session, and every parsed noun is looked up in it, so
+ * find() takes no lock and does not allocate. Names live in an append-only
+ * open-addressing index: intern() fills a free slot with a release store,
+ * and when the index gets too full it builds a twice larger one and
+ * publishes it with a single atomic pointer store. Older indexes stay
+ * allocated until the table is destroyed, so a reader never touches freed
+ * memory; together they are smaller than the current one.
+ */
+class SymbolTable {
+ public:
+    SymbolTable() = default;
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    /**
+     * @brief Get the table shared by the whole process
+     * @return The global table
+     */
+    static SymbolTable& global();
+
+    /**
+     * @brief Get the symbol of a name, adding the name if it is new
+     * @param text The name, in any case
+     * @return Its symbol, never kNoSymbol
+     */
+    Symbol intern(std::string_view text);
+
+    /**
+     * @brief Get the symbol of a name without adding it
+     * @param text The name, in any case
+     * @return Its symbol, or kNoSymbol if it was never interned
+     */
+    Symbol find(std::string_view text) const;
+
+    /**
+     * @brief Get the number of interned names
+     * @return Symbol count
+     */
+    size_t size() const;
+
+ private:
+    static constexpr size_t kInitialSlots = 64;  ///< Slots in the first index, a power of two
+
+    /**
+     * @brief An interned name
+     */
+    struct Entry {
+        size_t hash;       ///< Case-folded hash of name
+        Symbol symbol;     ///< The name's symbol
+        std::string name;  ///< The name as first interned
+    };
+
+    /**
+     * @brief One generation of the open-addressing index
+     */
+    struct Index {
+        size_t mask;                                          ///< Slot count minus one
+        std::unique_ptr<std::atomic<const Entry*>[]> slots;   ///< Entries by hash, nullptr if free
+
+        explicit Index(size_t slotCount);
+    };
+
+    /**
+     * @brief Hash a name ignoring ASCII case
+     * @param text The name
+     * @return FNV-1a hash of the lowercased bytes
+     */
+    static size_t foldedHash(std::string_view text);
+
+    /**
+     * @brief Compare two names ignoring ASCII case
+     * @return true if they are the same name
+     */
+    static bool foldedEqual(std::string_view a, std::string_view b);
+
+    /**
+     * @brief Look a name up in one index generation
+     * @param index The index to probe
+     * @param text The name
+     * @param hash foldedHash(text)
+     * @return Its entry, nullptr if not in this index
+     */
+    static const Entry* probe(const Index& index, std::string_view text, size_t hash);
+
+    /**
+     * @brief Put an entry in the first free slot of its probe sequence
+     * @param index The index to fill, with at least one free slot
+     * @param entry The entry to publish
+     */
+    static void place(Index& index, const Entry* entry);
+
+    std::atomic<const Index*> index_{nullptr};   ///< Current index, nullptr until the first intern()
+    std::atomic<size_t> count_{0};               ///< Number of interned names
+    std::mutex mutex_;                           ///< Serializes intern() calls that add a name
+    std::deque<Entry> entries_;                  ///< Every interned name, in symbol order (mutex_)
+    std::vector<std::unique_ptr<Index>> indexes_;  ///< Every index generation, newest last (mutex_)
+};
+
+#endif  // SYMBOL_TABLE_H_
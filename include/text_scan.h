@@ -0,0 +1,60 @@
+#ifndef TEXT_SCAN_H_
+#define TEXT_SCAN_H_
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+/**
+ * Bulk scanning of player input.
+ *
+ * These functions look at 32 (AVX2) or 16 (SSE2) bytes per step on x86 and
+ * fall back to plain loops elsewhere; AVX2 is picked at run time, so the
+ * binary still runs on machines without it. All character classes are
+ * fixed ASCII/UTF-8 rules and never depend on the C locale.
+ */
+
+/**
+ * @brief Find the next occurrence of a byte
+ * @param text Text to search
+ * @param byte Byte to look for
+ * @param from Index to start at
+ * @return Index of the byte, std::string_view::npos if absent
+ */
+size_t findByte(std::string_view text, char byte, size_t from = 0);
+
+/**
+ * @brief Check that a line is acceptable command text
+ *
+ * ASCII letters, digits and whitespace are allowed, and so is any
+ * well-formed UTF-8 sequence for a non-ASCII character. ASCII punctuation,
+ * control characters, overlong encodings, surrogates and truncated
+ * sequences are rejected.
+ *
+ * @param text The line
+ * @return true if the line may be parsed
+ */
+bool isCommandText(std::string_view text);
+
+/**
+ * @brief Check whether a byte is ASCII whitespace
+ * @param c The byte
+ * @return true for space, tab, newline, vertical tab, form feed and carriage return
+ */
+inline bool isAsciiSpace(char c) {
+    return c == ' ' || static_cast<unsigned char>(c - '\t') < 5;
+}
+
+/**
+ * @brief Lowercase text in place
+ *
+ * Folds ASCII letters and the accented capitals of the Latin-1 supplement
+ * (U+00C0 to U+00DE), which covers Western European names; other scripts
+ * pass through unchanged.
+ *
+ * @param text Text to fold; any string with contiguous storage converts
+ */
+void foldCase(std::span<char> text);
+
+#endif  // TEXT_SCAN_H_
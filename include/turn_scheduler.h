@@ -0,0 +1,145 @@
+#ifndef TURN_SCHEDULER_H_
+#define TURN_SCHEDULER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class TurnScheduler
+ * @brief Work-stealing thread pool that runs game turns
+ *
+ * Every worker owns a task deque. A worker pops its own newest task first
+ * (good cache locality for follow-up work it submitted itself) and, when its
+ * deque is empty, steals the oldest task from another worker.
+ *
+ * Tasks submitted from outside the pool are spread round-robin over the
+ * workers' inboxes, which run oldest first once the worker's own deque is
+ * empty, so under sustained load no outside task waits for the ones that
+ * arrived after it. A task that gives up its worker to be fair continues
+ * through requeue(), which puts it at the back of the worker's inbox,
+ * behind the work already waiting instead of in front of it.
+ *
+ * Beyond that the scheduler makes no ordering promises between tasks;
+ * callers that need per-session ordering keep at most one task per session
+ * in flight.
+ *
+ * Speculative work goes through submitIdle(): such tasks wait in a shared
+ * FIFO that workers only look at when no regular task is left to run or
+ * steal, so they soak up idle time without delaying turns.
+ */
+class TurnScheduler {
+ public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Constructor for TurnScheduler
+     * @param workerCount Number of worker threads, 0 for one per hardware thread
+     */
+    explicit TurnScheduler(size_t workerCount = 0);
+
+    /**
+     * @brief Destructor, runs remaining tasks and joins the workers
+     */
+    ~TurnScheduler();
+
+    TurnScheduler(const TurnScheduler&) = delete;
+    TurnScheduler& operator=(const TurnScheduler&) = delete;
+
+    /**
+     * @brief Run remaining tasks and join the workers
+     *
+     * Tasks may keep queueing follow-up work until the pool is idle. Tasks
+     * submitted after shutdown() returns never run.
+     */
+    void shutdown();
+
+    /**
+     * @brief Queue a task for execution
+     * @param task The task to run
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Queue a task behind all work waiting on the calling worker
+     *
+     * For continuations of work that yields its worker: submit() from a
+     * worker would run the task again before anything else queued there.
+     * Called from outside the pool it behaves like submit().
+     *
+     * @param task The task to run
+     */
+    void requeue(Task task);
+
+    /**
+     * @brief Queue a task to run only when a worker has nothing else to do
+     * @param task The task to run
+     */
+    void submitIdle(Task task);
+
+    /**
+     * @brief Get the number of worker threads
+     * @return Number of workers
+     */
+    size_t getWorkerCount() const { return workers_.size(); }
+
+ private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    /**
+     * @brief Per-thread state, padded so workers never share a cache line
+     */
+    struct alignas(kCacheLineSize) Worker {
+        std::mutex mutex;        ///< Guards tasks and inbox
+        std::deque<Task> tasks;  ///< Submitted by the owner; it pops from the back, thieves from the front
+        std::deque<Task> inbox;  ///< Outside and requeued tasks, oldest first
+        std::thread thread;      ///< The worker thread
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;  ///< All workers
+
+    alignas(kCacheLineSize) std::atomic<size_t> nextWorker_;  ///< Round-robin cursor for outside submissions
+    alignas(kCacheLineSize) std::atomic<size_t> pending_;     ///< Tasks queued but not yet taken
+    std::atomic<size_t> idlePending_;                         ///< Idle tasks queued but not yet taken
+    std::mutex idleTasksMutex_;                               ///< Guards idleTasks_
+    std::deque<Task> idleTasks_;                              ///< Tasks for otherwise idle workers, oldest first
+    std::mutex idleMutex_;                                    ///< Guards sleeping and stopping_
+    std::condition_variable idleCondition_;                   ///< Wakes sleeping workers
+    bool stopping_;                                           ///< Set once by the destructor
+
+    /**
+     * @brief Main loop of a worker thread
+     * @param index Index of the worker
+     */
+    void workerLoop(size_t index);
+
+    /**
+     * @brief Queue a task on a worker's deque or inbox and wake a sleeper
+     * @param task The task to run
+     * @param behind true to queue behind the calling worker's waiting tasks
+     */
+    void enqueue(Task task, bool behind);
+
+    /**
+     * @brief Take a task from the worker's own deque or steal one
+     * @param index Index of the calling worker
+     * @param task Receives the task
+     * @return true if a task was found
+     */
+    bool findTask(size_t index, Task& task);
+
+    /**
+     * @brief Take the oldest idle task
+     * @param task Receives the task
+     * @return true if a task was found
+     */
+    bool findIdleTask(Task& task);
+};
+
+#endif  // TURN_SCHEDULER_H_
@@ -0,0 +1,188 @@
+#ifndef VERB_TABLE_H_
+#define VERB_TABLE_H_
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+/**
+ * @brief One command verb: the words that invoke it, its help entry and handler
+ */
+template <typename Handler>
+struct Verb {
+    std::string_view name;      ///< Word that invokes the verb
+    std::string_view aliases;   ///< Other words for it, separated by spaces
+    std::string_view usage;     ///< Argument placeholder shown in help, may be empty
+    std::string_view category;  ///< Help section the verb is listed under
+    std::string_view help;      ///< One-line description shown in help
+    Handler handler;            ///< Function executing the verb
+};
+
+/**
+ * @brief Call a function for a verb's name and each of its aliases
+ * @param verb The verb
+ * @param visit Callback taking a std::string_view
+ */
+template <typename Handler, typename Visitor>
+constexpr void forEachWord(const Verb<Handler>& verb, Visitor visit) {
+    visit(verb.name);
+    std::string_view rest = verb.aliases;
+    while (!rest.empty()) {
+        size_t space = rest.find(' ');
+        if (space != 0) {
+            visit(rest.substr(0, space));
+        }
+        rest = space == std::string_view::npos ? std::string_view() : rest.substr(space + 1);
+    }
+}
+
+/**
+ * @brief Count the names and aliases of a list of verbs
+ * @param verbs The verbs
+ * @return Number of words that invoke some verb
+ */
+template <typename Handler, size_t N>
+constexpr size_t countWords(const std::array<Verb<Handler>, N>& verbs) {
+    size_t count = 0;
+    for (const auto& verb : verbs) {
+        forEachWord(verb, [&count](std::string_view) { ++count; });
+    }
+    return count;
+}
+
+/**
+ * @class VerbTable
+ * @brief Verb lookup through a perfect hash built at compile time
+ *
+ * Uses hash-and-displace: every word hashes to a bucket, and each bucket
+ * stores a displacement, found while the table is built, that sends its
+ * words to otherwise unused slots. A lookup is therefore one hash of the
+ * word, one bucket read and one string comparison, however many verbs there
+ * are. Duplicate words fail to compile.
+ *
+ * @tparam Handler Type of the verb handlers
+ * @tparam N Number of verbs
+ * @tparam Words Number of names and aliases, from countWords()
+ */
+template <typename Handler, size_t N, size_t Words>
+class VerbTable {
+ public:
+    static constexpr size_t kBuckets = (Words + 1) / 2;                ///< Displacement buckets
+    static constexpr size_t kSlots = std::bit_ceil(Words * 2);        ///< Hash slots, a power of two
+
+    /**
+     * @brief Build the table
+     * @param verbs The verbs to look up
+     */
+    consteval explicit VerbTable(const std::array<Verb<Handler>, N>& verbs)
+        : verbs_(verbs), displacements_{}, keys_{}, verbIndex_{} {
+        std::array<std::string_view, Words> words{};
+        std::array<uint16_t, Words> owners{};
+        size_t count = 0;
+        for (size_t i = 0; i < N; ++i) {
+            forEachWord(verbs[i], [&](std::string_view word) {
+                words[count] = word;
+                owners[count] = static_cast<uint16_t>(i);
+                ++count;
+            });
+        }
+
+        std::array<size_t, kBuckets> sizes{};
+        size_t largest = 0;
+        for (size_t i = 0; i < Words; ++i) {
+            size_t size = ++sizes[hashWord(words[i]) % kBuckets];
+            largest = size > largest ? size : largest;
+        }
+
+        // Place crowded buckets first, while the table is still mostly empty
+        std::array<bool, kSlots> used{};
+        for (size_t size = largest; size > 0; --size) {
+            for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+                if (sizes[bucket] == size) {
+                    placeBucket(bucket, words, owners, used);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Find the verb invoked by a word
+     * @param word Lowercase word typed by the player
+     * @return The verb, nullptr if the word is not a verb
+     */
+    constexpr const Verb<Handler>* find(std::string_view word) const {
+        uint32_t hash = hashWord(word);
+        size_t slot = mix(hash, displacements_[hash % kBuckets]) & (kSlots - 1);
+        return !word.empty() && keys_[slot] == word ? &verbs_[verbIndex_[slot]] : nullptr;
+    }
+
+    /**
+     * @brief Get the verbs in the order they were listed
+     * @return The verbs
+     */
+    constexpr const std::array<Verb<Handler>, N>& getVerbs() const { return verbs_; }
+
+ private:
+    std::array<Verb<Handler>, N> verbs_;              ///< The verbs, in listing order
+    std::array<uint32_t, kBuckets> displacements_;    ///< Per-bucket displacement
+    std::array<std::string_view, kSlots> keys_;       ///< Word stored in each slot
+    std::array<uint16_t, kSlots> verbIndex_;          ///< Verb owning each slot's word
+
+    static constexpr uint32_t hashWord(std::string_view word) {
+        uint32_t hash = 2166136261u;  // FNV-1a
+        for (char c : word) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+        }
+        return hash;
+    }
+
+    static constexpr uint32_t mix(uint32_t hash, uint32_t displacement) {
+        uint32_t x = hash ^ (displacement * 0x9E3779B9u);
+        x ^= x >> 16;
+        x *= 0x85EBCA6Bu;
+        x ^= x >> 13;
+        x *= 0xC2B2AE35u;
+        x ^= x >> 16;
+        return x;
+    }
+
+    consteval void placeBucket(size_t bucket, const std::array<std::string_view, Words>& words,
+                               const std::array<uint16_t, Words>& owners,
+                               std::array<bool, kSlots>& used) {
+        for (uint32_t displacement = 0; displacement < (1u << 20); ++displacement) {
+            std::array<size_t, Words> taken{};
+            size_t placed = 0;
+            bool fits = true;
+            for (size_t i = 0; i < Words && fits; ++i) {
+                uint32_t hash = hashWord(words[i]);
+                if (hash % kBuckets != bucket) continue;
+
+                size_t slot = mix(hash, displacement) & (kSlots - 1);
+                fits = !used[slot];
+                for (size_t j = 0; j < placed && fits; ++j) {
+                    if (words[taken[j]] == words[i]) {
+                        throw std::logic_error("duplicate verb word");
+                    }
+                    fits = (mix(hashWord(words[taken[j]]), displacement) & (kSlots - 1)) != slot;
+                }
+                taken[placed++] = i;
+            }
+            if (!fits) continue;
+
+            displacements_[bucket] = displacement;
+            for (size_t j = 0; j < placed; ++j) {
+                size_t slot = mix(hashWord(words[taken[j]]), displacement) & (kSlots - 1);
+                used[slot] = true;
+                keys_[slot] = words[taken[j]];
+                verbIndex_[slot] = owners[taken[j]];
+            }
+            return;
+        }
+        throw std::logic_error("no displacement found for verb bucket");
+    }
+};
+
+#endif  // VERB_TABLE_H_
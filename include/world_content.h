@@ -0,0 +1,82 @@
+#ifndef WORLD_CONTENT_H_
+#define WORLD_CONTENT_H_
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @class WorldContent
+ * @brief Immutable text published over the built-in world
+ *
+ * Holds replacement names and descriptions for locations and items, keyed
+ * by the name EnvironmentBuilder gives them. Anything without an entry keeps
+ * its built-in text. Content files look like:
+ *
+ *     # Comments start with '#'
+ *     [location Elder's House]
+ *     name = Elder's House
+ *     description = The home of Elder Elda.
+ *
+ *     [item Quest Scroll]
+ *     description = An ancient scroll detailing your mission.
+ *
+ * Once built a WorldContent is never modified, so any number of sessions may
+ * read it concurrently while a newer one is being published.
+ */
+class WorldContent {
+ public:
+    /**
+     * @brief Replacement text for a location
+     */
+    struct LocationText {
+        std::string name;         ///< Name shown in the location header
+        std::string description;  ///< Description shown below the header, empty to keep the built-in one
+    };
+
+    /**
+     * @brief Load content from a file
+     * @param path Content file to read
+     * @return The parsed content
+     * @throws std::runtime_error if the file cannot be read or is malformed
+     */
+    static std::unique_ptr<const WorldContent> load(const std::string& path);
+
+    /**
+     * @brief Parse content from a stream
+     * @param in Stream holding content in the format above
+     * @return The parsed content
+     * @throws std::runtime_error naming the offending line if the content is malformed
+     */
+    static std::unique_ptr<const WorldContent> parse(std::istream& in);
+
+    /**
+     * @brief Find the replacement text for a location
+     * @param name Built-in name of the location
+     * @return The replacement text, nullptr to keep the built-in text
+     */
+    const LocationText* findLocation(std::string_view name) const;
+
+    /**
+     * @brief Find the replacement description for an item
+     * @param name Name of the item
+     * @return The replacement description, nullptr to keep the built-in text
+     */
+    const std::string* findItemDescription(std::string_view name) const;
+
+    /**
+     * @brief Get the number of locations and items with replacement text
+     * @return Entry count
+     */
+    size_t getEntryCount() const { return locations_.size() + items_.size(); }
+
+ private:
+    std::map<std::string, LocationText, std::less<>> locations_;  ///< Location text by built-in name
+    std::map<std::string, std::string, std::less<>> items_;       ///< Item descriptions by name
+};
+
+#endif  // WORLD_CONTENT_H_
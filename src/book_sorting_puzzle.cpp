@@ -80,7 +80,7 @@ std::vector<std::string> BookSortingPuzzle::GetCurrentArrangement() const {
     return current_arrangement_;
 }
 
-bool BookSortingPuzzle::AttemptSolution(const std::string& /* attempt */) {
+bool BookSortingPuzzle::AttemptSolution(std::string_view /* attempt */) {
     if (!CanAttempt()) {
         throw PuzzleException("Cannot attempt puzzle: " + GetName());
     }
@@ -104,7 +104,7 @@ bool BookSortingPuzzle::AttemptSolution(const std::string& /* attempt */) {
     return false;
 }
 
-std::string BookSortingPuzzle::GetHint() const {
+std::string_view BookSortingPuzzle::GetHint() const {
     return hint_;
 }
 
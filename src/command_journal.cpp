@@ -0,0 +1,179 @@
+#include "command_journal.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+std::runtime_error journalError(const std::string& what) {
+    return std::runtime_error("Journal error: " + what + ": " + std::strerror(errno));
+}
+
+bool writeAll(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t result = write(fd, data.data() + written, data.size() - written);
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) return false;
+        written += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+bool syncDirectory(const std::string& directory) {
+    int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+}
+
+}  // namespace
+
+CommandJournal::Recovery CommandJournal::recover(const std::string& directory) {
+    Recovery recovery;
+    std::ifstream log(directory + "/journal.log", std::ios::binary);
+    if (!log) {
+        return recovery;
+    }
+
+    std::string contents((std::istreambuf_iterator<char>(log)), std::istreambuf_iterator<char>());
+    size_t start = 0;
+    size_t newline;
+    bool header = true;
+    // Only complete lines count; a torn tail was never committed
+    while ((newline = contents.find('\n', start)) != std::string::npos) {
+        std::string line = contents.substr(start, newline - start);
+        start = newline + 1;
+
+        if (header) {
+            header = false;
+            if (line.size() > 1 && line[0] == '@') {
+                recovery.checkpoint = std::stoull(line.substr(1));
+                continue;
+            }
+        }
+        recovery.commands.push_back(std::move(line));
+    }
+    return recovery;
+}
+
+CommandJournal::CommandJournal(const std::string& directory, const Recovery& recovery,
+                               size_t groupSize)
+    : directory_(directory),
+      fd_(-1),
+      buffered_(0),
+      groupSize_(groupSize == 0 ? 1 : groupSize),
+      checkpoint_(recovery.checkpoint),
+      entries_(recovery.commands.size()) {
+    if (mkdir(directory_.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw journalError("cannot create " + directory_);
+    }
+
+    fd_ = open(logPath().c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw journalError("cannot open " + logPath());
+    }
+
+    // Drop a torn tail so new entries start on a fresh line
+    struct stat info;
+    if (fstat(fd_, &info) == 0 && info.st_size == 0) {
+        buffer_ = "@" + std::to_string(checkpoint_) + "\n";
+        commit();
+    } else {
+        std::string valid = "@" + std::to_string(checkpoint_) + "\n";
+        for (const auto& command : recovery.commands) {
+            valid += command;
+            valid += '\n';
+        }
+        if (static_cast<size_t>(info.st_size) != valid.size() &&
+            ftruncate(fd_, static_cast<off_t>(valid.size())) != 0) {
+            throw journalError("cannot repair " + logPath());
+        }
+    }
+}
+
+CommandJournal::~CommandJournal() {
+    try {
+        commit();
+    } catch (const std::exception&) {
+        // Nothing sensible to do while destroying; the entries are lost
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+void CommandJournal::append(std::string_view command) {
+    buffer_.append(command);
+    buffer_.push_back('\n');
+    ++buffered_;
+    ++entries_;
+
+    if (buffered_ >= groupSize_) {
+        commit();
+    }
+}
+
+void CommandJournal::commit() {
+    if (buffer_.empty()) {
+        return;
+    }
+    if (!writeAll(fd_, buffer_) || fdatasync(fd_) != 0) {
+        throw journalError("cannot write " + logPath());
+    }
+    buffer_.clear();
+    buffered_ = 0;
+}
+
+std::string CommandJournal::nextCheckpointPath() const {
+    return checkpointPath(checkpoint_ + 1);
+}
+
+void CommandJournal::completeCheckpoint() {
+    // Anything still buffered is already part of the new snapshot
+    buffer_.clear();
+    buffered_ = 0;
+
+    std::string temporary = logPath() + ".tmp";
+    int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    std::string header = "@" + std::to_string(checkpoint_ + 1) + "\n";
+    bool ok = fd >= 0 && writeAll(fd, header) && fsync(fd) == 0;
+    if (fd >= 0) close(fd);
+    if (!ok || std::rename(temporary.c_str(), logPath().c_str()) != 0) {
+        unlink(temporary.c_str());
+        throw journalError("cannot start a new log in " + directory_);
+    }
+    // Make the new snapshot's entry and the rename durable before the old
+    // snapshot goes, or a crash could leave a log pointing at neither
+    if (!syncDirectory(directory_)) {
+        throw journalError("cannot sync " + directory_);
+    }
+
+    int newFd = open(logPath().c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (newFd < 0) {
+        throw journalError("cannot reopen " + logPath());
+    }
+    close(fd_);
+    fd_ = newFd;
+
+    // The previous snapshot is no longer referenced by the log
+    if (checkpoint_ > 0) {
+        unlink(checkpointPath(checkpoint_).c_str());
+    }
+    ++checkpoint_;
+    entries_ = 0;
+}
+
+std::string CommandJournal::checkpointPath(uint64_t checkpoint) const {
+    return directory_ + "/checkpoint-" + std::to_string(checkpoint) + ".snap";
+}
+
+std::string CommandJournal::logPath() const {
+    return directory_ + "/journal.log";
+}
@@ -1,64 +1,230 @@
 #include "command_parser.h"
-#include <iostream>
-#include <sstream>
+#include "text_scan.h"
 #include <algorithm>
-#include <cctype>
+#include <array>
 
-CommandParser::Command CommandParser::getCommand()
+namespace {
+
+/**
+ * @brief Role of a grammar word in a command
+ */
+enum class WordClass
+{
+    kNone,         ///< Part of a verb or a name
+    kArticle,      ///< Dropped from the start of an object
+    kPreposition,  ///< Ends the direct object and starts the indirect one
+    kSeparator     ///< Ends the command
+};
+
+/**
+ * @brief Entry of the grammar word table
+ */
+struct GrammarWord
+{
+    std::string_view word;  ///< The word, lowercase
+    WordClass wordClass;    ///< Its role
+};
+
+// Sorted so lookups are a binary search over one flat array. "of" is not a
+// preposition here: it belongs to names such as "Staff of Lumos"
+constexpr auto kGrammar = std::to_array<GrammarWord>({
+    {",", WordClass::kSeparator},
+    {"a", WordClass::kArticle},
+    {"an", WordClass::kArticle},
+    {"and", WordClass::kSeparator},
+    {"at", WordClass::kPreposition},
+    {"from", WordClass::kPreposition},
+    {"in", WordClass::kPreposition},
+    {"into", WordClass::kPreposition},
+    {"on", WordClass::kPreposition},
+    {"onto", WordClass::kPreposition},
+    {"the", WordClass::kArticle},
+    {"then", WordClass::kSeparator},
+    {"to", WordClass::kPreposition},
+    {"under", WordClass::kPreposition},
+    {"with", WordClass::kPreposition},
+});
+
+static_assert(std::is_sorted(kGrammar.begin(), kGrammar.end(),
+                             [](const GrammarWord& a, const GrammarWord& b) { return a.word < b.word; }),
+              "kGrammar must be sorted by word");
+
+/**
+ * @brief Look up the role of a word
+ * @param word A lowercase word of the line
+ * @return Its class, kNone for ordinary words
+ */
+WordClass classify(std::string_view word)
+{
+    // Every grammar word is short; longer words skip the search
+    if (word.size() > 5)
+    {
+        return WordClass::kNone;
+    }
+    auto it = std::lower_bound(kGrammar.begin(), kGrammar.end(), word,
+                               [](const GrammarWord& entry, std::string_view key) { return entry.word < key; });
+    return it != kGrammar.end() && it->word == word ? it->wordClass : WordClass::kNone;
+}
+
+/**
+ * @brief View the words [first, last) of a line as one phrase
+ * @param words The words, each viewing the same single-spaced buffer
+ * @param first Index of the first word
+ * @param last Index one past the last word
+ * @return The phrase, empty if first == last
+ */
+std::string_view joinWords(const std::string_view* words, size_t first, size_t last)
+{
+    if (first == last)
+    {
+        return {};
+    }
+    const char* begin = words[first].data();
+    return std::string_view(begin, words[last - 1].data() + words[last - 1].size() - begin);
+}
+
+}  // namespace
+
+bool CommandParser::isArticle(std::string_view word)
+{
+    return classify(word) == WordClass::kArticle;
+}
+
+bool CommandParser::isPreposition(std::string_view word)
 {
-    std::string input;
-    std::cout << "> ";
-    std::getline(std::cin, input);
-    return parseInput(input);
+    return classify(word) == WordClass::kPreposition;
 }
 
-CommandParser::Command CommandParser::parseInput(const std::string &input)
+CommandParser::Command CommandParser::parseInput(std::string_view input)
 {
-    Command cmd;
-    cmd.isValid = false;
+    auto batch = parseBatch(input);
+    return batch.size() == 1 ? batch.front() : Command{};
+}
 
+std::span<const CommandParser::Command> CommandParser::parseBatch(std::string_view input)
+{
     // Check for empty input
+    error_ = Error::kInvalid;
     if (input.empty())
     {
-        return cmd;
+        return {};
     }
 
-    // Validate input characters
-    if (!isValidInput(input))
+    // Validate input characters between the commas, and copy them into the
+    // reused buffer with every comma as a word of its own
+    line_.clear();
+    for (size_t offset = 0; offset <= input.size();)
     {
-        return cmd;
+        size_t end = std::min(findByte(input, ',', offset), input.size());
+        std::string_view piece = input.substr(offset, end - offset);
+        if (!isCommandText(piece))
+        {
+            return {};
+        }
+        if (offset > 0)
+        {
+            line_ += " , ";
+        }
+        line_ += piece;
+        offset = end + 1;
     }
 
-    // Convert to lowercase and parse
-    std::string lowercaseInput = toLowerCase(input);
-    std::istringstream stream(lowercaseInput);
-
-    // Get the main command
-    stream >> cmd.action;
+    // Lowercase, then collapse runs of whitespace in place so consecutive
+    // words are exactly one space apart
+    foldCase(line_);
+    size_t length = 0;
+    for (char c : line_)
+    {
+        if (!isAsciiSpace(c))
+        {
+            line_[length++] = c;
+        }
+        else if (length > 0 && line_[length - 1] != ' ')
+        {
+            line_[length++] = ' ';
+        }
+    }
+    if (length > 0 && line_[length - 1] == ' ')
+    {
+        --length;
+    }
+    line_.resize(length);
+    if (line_.empty())
+    {
+        return {};
+    }
 
-    // Get any arguments
-    std::string arg;
-    while (stream >> arg)
+    // Split into words and classify them
+    std::string_view line = line_;
+    std::array<WordClass, kMaxTokens> classes;
+    size_t count = 0;
+    for (size_t offset = 0; offset <= line.size();)
     {
-        cmd.arguments.push_back(arg);
+        if (count == kMaxTokens)
+        {
+            error_ = Error::kTooManyWords;
+            return {};
+        }
+        size_t end = std::min(findByte(line, ' ', offset), line.size());
+        tokens_[count] = line.substr(offset, end - offset);
+        classes[count] = classify(tokens_[count]);
+        ++count;
+        offset = end + 1;
     }
 
-    cmd.isValid = true;
-    return cmd;
-}
+    // Group the words between separators into commands; empty groups, as
+    // in "look, , inventory" or a trailing "then", are skipped
+    size_t commands = 0;
+    for (size_t first = 0; first < count;)
+    {
+        size_t last = first;
+        while (last < count && classes[last] != WordClass::kSeparator)
+        {
+            ++last;
+        }
+        if (last > first)
+        {
+            if (commands == kMaxCommands)
+            {
+                error_ = Error::kTooManyCommands;
+                return {};
+            }
+            Command& cmd = commands_[commands++];
+            cmd.action = tokens_[first];
+            cmd.arguments = std::span<const std::string_view>(tokens_.data() + first + 1, last - first - 1);
 
-bool CommandParser::isValidInput(const std::string &input) const
-{
-    return std::all_of(input.begin(), input.end(),
-                       [](char ch)
-                       { return std::isalnum(ch) || std::isspace(ch); });
-}
+            // verb [article] direct-object [preposition [article] indirect-object];
+            // the phrases are already joined in the buffer
+            size_t word = first + 1;
+            if (word < last && classes[word] == WordClass::kArticle)
+            {
+                ++word;
+            }
+            size_t nounStart = word;
+            while (word < last && classes[word] != WordClass::kPreposition)
+            {
+                ++word;
+            }
+            cmd.noun = joinWords(tokens_.data(), nounStart, word);
+            cmd.preposition = {};
+            if (word < last)
+            {
+                cmd.preposition = tokens_[word++];
+                if (word < last && classes[word] == WordClass::kArticle)
+                {
+                    ++word;
+                }
+            }
+            cmd.indirect = joinWords(tokens_.data(), word, last);
 
-std::string CommandParser::toLowerCase(const std::string &input) const
-{
-    std::string result = input;
-    std::transform(result.begin(), result.end(), result.begin(),
-                   [](unsigned char c)
-                   { return std::tolower(c); });
-    return result;
-}
\ No newline at end of file
+            // Look the objects up once so handlers compare symbols, not strings
+            cmd.object = cmd.noun.empty() ? kNoSymbol : SymbolTable::global().find(cmd.noun);
+            cmd.indirectObject = cmd.indirect.empty() ? kNoSymbol : SymbolTable::global().find(cmd.indirect);
+            cmd.isValid = true;
+        }
+        first = last + 1;
+    }
+
+    error_ = Error::kNone;
+    return std::span<const Command>(commands_.data(), commands);
+}
@@ -0,0 +1,20 @@
+#include "content_store.h"
+#include <stdexcept>
+
+ContentStore::ContentStore()
+    : current_(new WorldContent()), version_(0) {}
+
+ContentStore::~ContentStore() {
+    delete current_.load();
+}
+
+void ContentStore::publish(std::unique_ptr<const WorldContent> content) {
+    if (!content) {
+        throw std::invalid_argument("Cannot publish empty world content");
+    }
+
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    const WorldContent* previous = current_.exchange(content.release());
+    version_.fetch_add(1, std::memory_order_release);
+    reclaimer_.retire([previous] { delete previous; });
+}
@@ -5,32 +5,37 @@
 #include "npc.h"
 #include <array>
 
-std::unique_ptr<LocationGrid> EnvironmentBuilder::buildEnvironment(EnvironmentType type) {
+std::unique_ptr<LocationGrid> EnvironmentBuilder::buildEnvironment(EnvironmentType type, LocationStore& store) {
     switch (type) {
         case EnvironmentType::VILLAGE_OF_LUMINARA:
-            return createVillageOfLuminara();
+            return createVillageOfLuminara(store);
         case EnvironmentType::WHISPERING_WOODS:
-            return createWhisperingWoods();
+            return createWhisperingWoods(store);
         case EnvironmentType::CRYSTAL_CAVES:
-            return createCrystalCaves();
+            return createCrystalCaves(store);
         case EnvironmentType::FORGOTTEN_LIBRARY:
-            return createForgottenLibrary();
+            return createForgottenLibrary(store);
         case EnvironmentType::ECHOING_MOUNTAINS:
-            return createEchoingMountains();
+            return createEchoingMountains(store);
         case EnvironmentType::SHADOW_MARSHES:
-            return createShadowMarshes();
+            return createShadowMarshes(store);
         case EnvironmentType::SANCTUM_OF_LIGHT:
-            return createSanctumOfLight();
+            return createSanctumOfLight(store);
         case EnvironmentType::MALAKARS_LAIR:
-            return createMalakarsLair();
+            return createMalakarsLair(store);
         case EnvironmentType::HIDDEN_GROVE:
-            return createHiddenGrove();
+            return createHiddenGrove(store);
+        // Procedural regions start empty; ProceduralRegion fills them on approach
+        case EnvironmentType::MARSH_WILDS:
+            return std::make_unique<LocationGrid>("Endless Marsh", LocationGrid::MAX_SIZE, LocationGrid::MAX_SIZE);
+        case EnvironmentType::MOUNTAIN_WILDS:
+            return std::make_unique<LocationGrid>("Mountain Wilds", LocationGrid::MAX_SIZE, LocationGrid::MAX_SIZE);
         default:
             return nullptr;
     }
 }
 
-std::unique_ptr<LocationGrid> EnvironmentBuilder::createVillageOfLuminara() {
+std::unique_ptr<LocationGrid> EnvironmentBuilder::createVillageOfLuminara(LocationStore& store) {
     std::array<std::array<LocationData, LocationGrid::GRID_SIZE>,
                LocationGrid::GRID_SIZE> locations = {{
         // First row (0,0 to 2,0)
@@ -77,10 +82,10 @@ std::unique_ptr<LocationGrid> EnvironmentBuilder::createVillageOfLuminara() {
         "An ancient scroll detailing your mission to save Eldoria."  // Description
     ));
 
-    return createBasicGrid("Village of Luminara", locations);
+    return createBasicGrid(store, "Village of Luminara", locations);
 }
 
-std::unique_ptr<LocationGrid> EnvironmentBuilder::createWhisperingWoods() {
+std::unique_ptr<LocationGrid> EnvironmentBuilder::createWhisperingWoods(LocationStore& store) {
     std::array<std::array<LocationData, LocationGrid::GRID_SIZE>,
                LocationGrid::GRID_SIZE> locations = {{
         // First row
@@ -134,10 +139,10 @@ std::unique_ptr<LocationGrid> EnvironmentBuilder::createWhisperingWoods() {
         "A magical map that seems to shift and change as you watch."
     ));
 
-    return createBasicGrid("Whispering Woods", locations);
+    return createBasicGrid(store, "Whispering Woods", locations);
 }
 
-std::unique_ptr<LocationGrid> EnvironmentBuilder::createCrystalCaves() {
+std::unique_ptr<LocationGrid> EnvironmentBuilder::createCrystalCaves(LocationStore& store) {
     std::array<std::array<LocationData, LocationGrid::GRID_SIZE>,
                LocationGrid::GRID_SIZE> locations = {{
         // First row
@@ -188,14 +193,14 @@ std::unique_ptr<LocationGrid> EnvironmentBuilder::createCrystalCaves() {
     // Add Crystal Lens item
     locations[1][1].items.push_back(std::make_shared<CrystalLens>());
 
-    return createBasicGrid("Crystal Caves", locations);
+    return createBasicGrid(store, "Crystal Caves", locations);
 }
 
 // ... Similar implementations for other environments ...
 
 // Add these implementations to your existing environment_builder.cpp file
 
-std::unique_ptr<LocationGrid> EnvironmentBuilder::createForgottenLibrary() {
+std::unique_ptr<LocationGrid> EnvironmentBuilder::createForgottenLibrary(LocationStore& store) {
     std::array<std::array<LocationData, LocationGrid::GRID_SIZE>,
                LocationGrid::GRID_SIZE> locations = {{
         // First row
@@ -234,10 +239,10 @@ std::unique_ptr<LocationGrid> EnvironmentBuilder::createForgottenLibrary() {
         "The ancient knowledge held here must be properly ordered..."
     ));
 
-    return createBasicGrid("Forgotten Library", locations);
+    return createBasicGrid(store, "Forgotten Library", locations);
 }
 
-std::unique_ptr<LocationGrid> EnvironmentBuilder::createEchoingMountains() {
+std::unique_ptr<LocationGrid> EnvironmentBuilder::createEchoingMountains(LocationStore& store) {
     std::array<std::array<LocationData, LocationGrid::GRID_SIZE>,
                LocationGrid::GRID_SIZE> locations = {{
         // First row
@@ -269,10 +274,10 @@ std::unique_ptr<LocationGrid> EnvironmentBuilder::createEchoingMountains() {
         }}
     }};
 
-    return createBasicGrid("Echoing Mountains", locations);
+    return createBasicGrid(store, "Echoing Mountains", locations);
 }
 
-std::unique_ptr<LocationGrid> EnvironmentBuilder::createShadowMarshes() {
+std::unique_ptr<LocationGrid> EnvironmentBuilder::createShadowMarshes(LocationStore& store) {
     std::array<std::array<LocationData, LocationGrid::GRID_SIZE>,
                LocationGrid::GRID_SIZE> locations = {{
         // First row
@@ -304,10 +309,10 @@ std::unique_ptr<LocationGrid> EnvironmentBuilder::createShadowMarshes() {
         }}
     }};
 
-    return createBasicGrid("Shadow Marshes", locations);
+    return createBasicGrid(store, "Shadow Marshes", locations);
 }
 
-std::unique_ptr<LocationGrid> EnvironmentBuilder::createSanctumOfLight() {
+std::unique_ptr<LocationGrid> EnvironmentBuilder::createSanctumOfLight(LocationStore& store) {
     std::array<std::array<LocationData, LocationGrid::GRID_SIZE>,
                LocationGrid::GRID_SIZE> locations = {{
         // First row
@@ -346,10 +351,10 @@ std::unique_ptr<LocationGrid> EnvironmentBuilder::createSanctumOfLight() {
         "To wield the Staff of Lumos, one must first prove their worth..."
     ));
 
-    return createBasicGrid("Sanctum of Light", locations);
+    return createBasicGrid(store, "Sanctum of Light", locations);
 }
 
-std::unique_ptr<LocationGrid> EnvironmentBuilder::createMalakarsLair() {
+std::unique_ptr<LocationGrid> EnvironmentBuilder::createMalakarsLair(LocationStore& store) {
     std::array<std::array<LocationData, LocationGrid::GRID_SIZE>,
                LocationGrid::GRID_SIZE> locations = {{
         // First row
@@ -381,10 +386,10 @@ std::unique_ptr<LocationGrid> EnvironmentBuilder::createMalakarsLair() {
         }}
     }};
 
-    return createBasicGrid("Malakar's Lair", locations);
+    return createBasicGrid(store, "Malakar's Lair", locations);
 }
 
-std::unique_ptr<LocationGrid> EnvironmentBuilder::createHiddenGrove() {
+std::unique_ptr<LocationGrid> EnvironmentBuilder::createHiddenGrove(LocationStore& store) {
     std::array<std::array<LocationData, LocationGrid::GRID_SIZE>,
                LocationGrid::GRID_SIZE> locations = {{
         // First row
@@ -423,10 +428,11 @@ std::unique_ptr<LocationGrid> EnvironmentBuilder::createHiddenGrove() {
         "The grove reveals its secrets only to those who are worthy..."
     ));
 
-    return createBasicGrid("Hidden Grove", locations);
+    return createBasicGrid(store, "Hidden Grove", locations);
 }
 
 std::unique_ptr<LocationGrid> EnvironmentBuilder::createBasicGrid(
+    LocationStore& store,
     const std::string& name,
     const std::array<std::array<LocationData, LocationGrid::GRID_SIZE>,
                     LocationGrid::GRID_SIZE>& locations) {
@@ -437,7 +443,7 @@ std::unique_ptr<LocationGrid> EnvironmentBuilder::createBasicGrid(
     for (int y = 0; y < LocationGrid::GRID_SIZE; ++y) {
         for (int x = 0; x < LocationGrid::GRID_SIZE; ++x) {
             const auto& data = locations[y][x];
-            auto location = std::make_shared<Location>(data.name, data.description);
+            Location* location = store.create(data.name, data.description);
 
             // Add items
             for (const auto& item : data.items) {
@@ -455,6 +461,7 @@ std::unique_ptr<LocationGrid> EnvironmentBuilder::createBasicGrid(
             }
 
             grid->setLocation(x, y, location);
+            store.setPlacement(location->getId(), grid.get(), x, y);
         }
     }
 
@@ -0,0 +1,133 @@
+#include "epoch_reclaimer.h"
+#include <atomic>
+#include <limits>
+
+namespace {
+
+constexpr uint64_t kIdle = std::numeric_limits<uint64_t>::max();
+
+/**
+ * @brief Epoch announced by one thread, padded to its own cache line
+ */
+struct alignas(64) ReaderSlot {
+    std::atomic<uint64_t> epoch{kIdle};  ///< Epoch being read in, kIdle outside a guard
+    std::atomic<bool> claimed{false};    ///< Owned by a live thread
+    ReaderSlot* next = nullptr;          ///< Next slot in the registry, immutable once linked
+};
+
+std::atomic<uint64_t> globalEpoch{1};
+std::atomic<ReaderSlot*> slots{nullptr};
+
+// Slots are reused by later threads and never freed, so the registry only
+// grows to the peak number of threads that have read concurrently
+ReaderSlot* claimSlot() {
+    for (ReaderSlot* slot = slots.load(std::memory_order_acquire); slot; slot = slot->next) {
+        bool expected = false;
+        if (!slot->claimed.load(std::memory_order_relaxed) &&
+            slot->claimed.compare_exchange_strong(expected, true)) {
+            return slot;
+        }
+    }
+
+    auto* slot = new ReaderSlot;
+    slot->claimed.store(true, std::memory_order_relaxed);
+    slot->next = slots.load(std::memory_order_relaxed);
+    while (!slots.compare_exchange_weak(slot->next, slot, std::memory_order_release,
+                                        std::memory_order_relaxed)) {}
+    return slot;
+}
+
+/**
+ * @brief The calling thread's slot and guard nesting depth
+ */
+struct ThreadReader {
+    ReaderSlot* slot = nullptr;
+    unsigned depth = 0;
+
+    ~ThreadReader() {
+        if (slot) {
+            slot->epoch.store(kIdle, std::memory_order_release);
+            slot->claimed.store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadReader threadReader;
+
+// Oldest epoch a reader is still inside, kIdle if none
+uint64_t oldestActiveEpoch() {
+    uint64_t oldest = kIdle;
+    for (ReaderSlot* slot = slots.load(std::memory_order_acquire); slot; slot = slot->next) {
+        uint64_t epoch = slot->epoch.load();
+        if (epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+    return oldest;
+}
+
+}  // namespace
+
+EpochReclaimer::ReadGuard::ReadGuard() {
+    ThreadReader& reader = threadReader;
+    if (reader.depth++ > 0) {
+        return;
+    }
+    if (!reader.slot) {
+        reader.slot = claimSlot();
+    }
+    // Sequentially consistent so a writer scanning the slots after
+    // unpublishing either sees this epoch or we see its new pointer
+    reader.slot->epoch.store(globalEpoch.load());
+}
+
+EpochReclaimer::ReadGuard::~ReadGuard() {
+    ThreadReader& reader = threadReader;
+    if (--reader.depth == 0) {
+        reader.slot->epoch.store(kIdle, std::memory_order_release);
+    }
+}
+
+EpochReclaimer::~EpochReclaimer() {
+    for (auto& retired : retired_) {
+        retired.destroy();
+    }
+}
+
+void EpochReclaimer::retire(std::function<void()> destroy) {
+    uint64_t epoch = globalEpoch.fetch_add(1) + 1;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired_.push_back({epoch, std::move(destroy)});
+        pending_.store(retired_.size(), std::memory_order_relaxed);
+    }
+    collect();
+}
+
+void EpochReclaimer::collect() {
+    if (pending_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    std::vector<Retired> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t oldest = oldestActiveEpoch();
+
+        // Readers that entered at or after the retire epoch saw the replacement
+        std::vector<Retired> waiting;
+        for (auto& retired : retired_) {
+            (retired.epoch <= oldest ? ready : waiting).push_back(std::move(retired));
+        }
+        retired_.swap(waiting);
+        pending_.store(retired_.size(), std::memory_order_relaxed);
+    }
+
+    for (auto& retired : ready) {
+        retired.destroy();
+    }
+}
+
+size_t EpochReclaimer::getPendingCount() const {
+    return pending_.load(std::memory_order_relaxed);
+}
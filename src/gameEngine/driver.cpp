@@ -0,0 +1,40 @@
+#include "driver.h"
+#include "game_engine.h"
+#include "output_buffer.h"
+#include <iostream>
+#include <string>
+
+namespace {
+
+const char* const kPrompt = "\n> ";
+
+}  // namespace
+
+Driver::Driver(GameEngine& engine, std::istream& in, int outFd)
+    : engine_(engine), in_(in), outFd_(outFd) {}
+
+int Driver::run() {
+    // A session recovered from a journal resumes where it left off
+    GameEngine::TurnResult result = engine_.isRunning() ? engine_.step("look") : engine_.start();
+
+    int turns = 0;
+    std::string line;
+    while (engine_.isRunning()) {
+        writeFully(outFd_, {result.output, kPrompt});
+        engine_.commitJournal();
+        engine_.prerender();
+        if (!std::getline(in_, line)) {
+            // End of input behaves like an explicit quit
+            line = "quit";
+        }
+
+        result = engine_.step(line);
+        ++turns;
+
+        if (result.quit) {
+            break;
+        }
+    }
+    writeFully(outFd_, {result.output});
+    return turns;
+}
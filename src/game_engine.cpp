@@ -1,403 +1,1098 @@
 #include "game_engine.h"
+#include "driver.h"
 #include "npc.h"
 #include "usable_item.h"
+#include "riddle_puzzle.h"
+#include "reflection_puzzle.h"
+#include "book_sorting_puzzle.h"
+#include "name_index.h"
+#include "snapshot.h"
+#include "text_scan.h"
+#include "verb_table.h"
 #include <iostream>
-#include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <cctype>
+#include <optional>
+#include <unistd.h>
+
+namespace {
+
+// Lowercase and trim a dialog reply so keywords match however they are typed
+std::pmr::string normalizeReply(std::string_view reply, std::pmr::memory_resource* memory) {
+    size_t first = std::min(reply.find_first_not_of(" \t"), reply.size());
+    reply = reply.substr(first, reply.find_last_not_of(" \t") + 1 - first);
+    std::pmr::string result(reply, memory);
+    foldCase(result);
+    return result;
+}
+
+// Text of consecutive commands from one batch, which all view the parser's line buffer
+std::string_view batchText(std::span<const CommandParser::Command> commands) {
+    if (commands.empty()) {
+        return {};
+    }
+    const CommandParser::Command& last = commands.back();
+    std::string_view end = last.arguments.empty() ? last.action : last.arguments.back();
+    return std::string_view(commands.front().action.data(), end.data() + end.size());
+}
+
+// Input stream over a reply that keeps its buffer in a turn arena
+using ReplyStream = std::basic_istringstream<char, std::char_traits<char>, std::pmr::polymorphic_allocator<char>>;
+
+struct DirectionName {
+    std::string_view name;
+    Location::Direction direction;
+};
+
+constexpr DirectionName kDirections[] = {
+    {"north", Location::Direction::NORTH},
+    {"east", Location::Direction::EAST},
+    {"south", Location::Direction::SOUTH},
+    {"west", Location::Direction::WEST},
+};
+
+// Match a direction by name or by any prefix of it ("n", "nor"); the four
+// names start with different letters, so a prefix is never ambiguous
+const DirectionName* findDirection(std::string_view word) {
+    if (word.empty()) return nullptr;
+    for (const auto& direction : kDirections) {
+        if (direction.name.starts_with(word)) return &direction;
+    }
+    return nullptr;
+}
+
+// Case-insensitive prefix test for text typed into complete()
+bool startsWithTyped(std::string_view word, std::string_view typed) {
+    return word.size() >= typed.size() &&
+           std::equal(typed.begin(), typed.end(), word.begin(), [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+           });
+}
+
+// Allow one typo per four letters typed, up to two
+size_t typoAllowance(std::string_view text) {
+    return std::min<size_t>(2, text.size() / 4);
+}
+
+std::unique_ptr<Player> createPlayer() {
+    // Initialize player (will be expanded in future phases)
+    return std::make_unique<Player>("Aric", "A courageous adventurer destined to save Eldoria.");
+}
+
+}  // namespace
+
+/**
+ * @brief Every verb the parser understands, in the order help lists them
+ */
+struct GameEngine::Verbs {
+    using Handler = bool (*)(GameEngine&, const CommandParser::Command&);
+
+    static constexpr auto kList = std::to_array<Verb<Handler>>({
+        {"go", "move", "[direction]", "Movement",
+         "Move in specified direction (north, south, east, west)",
+         [](GameEngine& engine, const CommandParser::Command& command) { return engine.handleMovement(command); }},
+        {"look", "", "", "Environment", "Look around your current location",
+         [](GameEngine& engine, const CommandParser::Command&) { engine.showLocation(); return true; }},
+        {"examine", "", "[item]", "Environment", "Look at a specific item or feature",
+         [](GameEngine& engine, const CommandParser::Command& command) { return engine.handleExamine(command); }},
+        {"solve", "", "", "Environment", "Work on the puzzle at your location",
+         [](GameEngine& engine, const CommandParser::Command& command) { return engine.handleSolve(command); }},
+        {"take", "pickup", "[item]", "Item Management", "Pick up an item",
+         [](GameEngine& engine, const CommandParser::Command& command) { return engine.handlePickup(command); }},
+        {"drop", "", "[item]", "Item Management", "Drop an item from your inventory",
+         [](GameEngine& engine, const CommandParser::Command& command) { return engine.handleDrop(command); }},
+        {"inventory", "inv", "", "Item Management", "Show your inventory",
+         [](GameEngine& engine, const CommandParser::Command&) { engine.displayInventory(); return true; }},
+        {"use", "", "[item] (on [target])", "Item Management", "Use an item, optionally on something",
+         [](GameEngine& engine, const CommandParser::Command& command) { return engine.handleUse(command); }},
+        {"give", "", "[item] to [npc]", "Item Management", "Give an item to someone",
+         [](GameEngine& engine, const CommandParser::Command& command) { return engine.handleGive(command); }},
+        {"help", "", "", "System", "Show this help message",
+         [](GameEngine& engine, const CommandParser::Command&) { engine.displayHelp(); return true; }},
+        {"quit", "", "", "System", "Exit the game",
+         [](GameEngine& engine, const CommandParser::Command&) { engine.stop(); return true; }},
+    });
+
+    static constexpr VerbTable<Handler, kList.size(), countWords(kList)> kTable{kList};
+
+    /**
+     * @brief Index of verb names for abbreviations and typos
+     *
+     * Aliases are left out so that "i" is not torn between "inventory"
+     * and "inv"; they still match exactly through kTable.
+     *
+     * @return The index, built on first use and shared by all sessions
+     */
+    static const NameIndex& index() {
+        static const NameIndex words = [] {
+            NameIndex index;
+            for (const auto& verb : kList) {
+                index.insert(verb.name);
+            }
+            return index;
+        }();
+        return words;
+    }
+};
 
 GameEngine::GameEngine() 
     : running_(false), 
       gameWorld_(nullptr),
-      currentPlayer_(nullptr) {
+      currentPlayer_(nullptr),
+      checkpointInterval_(0),
+      content_(nullptr),
+      deferLocation_(false),
+      locationPending_(false),
+      worldVersion_(0),
+      turnArena_(turnBuffer_.data(), turnBuffer_.size()) {
 }
 
 void GameEngine::run() {
-    initialize();
-    running_ = true;
+    Driver driver(*this, std::cin, STDOUT_FILENO);
+    driver.run();
+}
 
-    // Display welcome message and initial location
-    displayWelcomeMessage();
-    displayCurrentLocation();
+GameEngine::TurnResult GameEngine::start() {
+    beginTurn();
+    openGame();
+    return finishTurn();
+}
+
+GameEngine::TurnResult GameEngine::step(std::string_view input) {
+    beginTurn();
+    if (!gameWorld_) {
+        // Callers that skip start() still see the opening text
+        openGame();
+    }
 
-    // Main game loop
-    while (running_) {
-        processTurn();
+    bool inDialog = dialog_.isActive();
+    if (running_ && dialog_.isActive()) {
+        try {
+            dialogInput_.deliver(input);
+            dialog_.rethrowIfFailed();
+        } catch (const std::exception& e) {
+            output_ << "Error processing turn: " << e.what() << "\n";
+        }
+        if (!dialog_.isActive()) {
+            dialog_.reset();
+        }
+    } else if (running_) {
+        input = processTurn(input);
+    }
+    recordTurn(input, inDialog);
+
+    if (!running_) {
+        turn_.quit = true;
+        output_ << "\nThank you for playing Eldoria: Shadows of Malakar!\n";
+    }
+    return finishTurn();
+}
+
+void GameEngine::recordTurn(std::string_view input, bool inDialog) {
+    if (!journal_) {
+        return;
     }
 
-    std::cout << "\nThank you for playing Eldoria: Shadows of Malakar!\n";
+    // Dialog lines only make sense replayed together with the line that
+    // opened the dialog, so they are logged even when nothing changed
+    if (!input.empty() && (turn_.locationChanged || turn_.inventoryChanged || turn_.worldChanged ||
+                           inDialog || dialog_.isActive())) {
+        journal_->append(input);
+    }
+
+    // Snapshots cannot hold a dialog in progress, so wait until it ends
+    if (journal_->getEntryCount() >= checkpointInterval_ && !dialog_.isActive() && running_) {
+        saveSnapshot(journal_->nextCheckpointPath());
+        journal_->completeCheckpoint();
+    }
+}
+
+void GameEngine::openGame() {
+    initialize();
+    running_ = gameWorld_ != nullptr;
+
+    // Display welcome message and initial location
+    if (running_) {
+        rebuildNameIndex();
+        displayWelcomeMessage();
+        displayCurrentLocation();
+    }
 }
 
 void GameEngine::initialize() {
     try {
         // Initialize game world
         gameWorld_ = std::make_unique<GameWorld>();
+        ++worldVersion_;
         
-        // Initialize player (will be expanded in future phases)
-        currentPlayer_ = std::make_unique<Player>("Aric", "A courageous adventurer destined to save Eldoria.");
+        currentPlayer_ = createPlayer();
         
         // Ensure initialization was successful
         if (!gameWorld_->getCurrentLocation()) {
             throw std::runtime_error("Failed to initialize starting location");
         }
     } catch (const std::exception& e) {
-        std::cerr << "Initialization error: " << e.what() << std::endl;
+        output_ << "Initialization error: " << e.what() << "\n";
+        gameWorld_.reset();
         running_ = false;
     }
 }
 
-void GameEngine::processTurn() {
+std::string_view GameEngine::processTurn(std::string_view input) {
     try {
-        std::cout << "\n> ";
-        auto command = commandParser_.getCommand();
+        auto batch = commandParser_.parseBatch(input);
+        if (batch.empty()) {
+            switch (commandParser_.getError()) {
+                case CommandParser::Error::kTooManyWords:
+                    output_ << "Too many words in one line (at most " << CommandParser::kMaxTokens << ").\n";
+                    break;
+                case CommandParser::Error::kTooManyCommands:
+                    output_ << "Too many commands in one line (at most " << CommandParser::kMaxCommands << ").\n";
+                    break;
+                default:
+                    output_ << "Invalid command. Type 'help' for a list of commands.\n";
+                    break;
+            }
+            return input;
+        }
 
-        if (command.isValid) {
-            executeCommand(command);
-        } else {
-            std::cout << "Invalid command. Type 'help' for a list of commands.\n";
+        // Later commands assume the earlier ones worked, so stop at the
+        // first failure, on quit, or when a dialog takes over the input
+        deferLocation_ = batch.size() > 1;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            bool succeeded = executeCommand(batch[i]);
+            if (!running_) {
+                // Replaying the quit would end the recovered session too
+                input = batchText(batch.first(i));
+                break;
+            }
+            if (i + 1 < batch.size() && (!succeeded || dialog_.isActive())) {
+                if (!succeeded) {
+                    output_ << "Stopped before \"" << batch[i + 1].action << "\".\n";
+                }
+                break;
+            }
         }
     } catch (const std::exception& e) {
-        std::cerr << "Error processing turn: " << e.what() << std::endl;
+        output_ << "Error processing turn: " << e.what() << "\n";
+    }
+    deferLocation_ = false;
+    flushLocation();
+    return input;
+}
+
+void GameEngine::showLocation() {
+    if (deferLocation_) {
+        locationPending_ = true;
+    } else {
+        displayCurrentLocation();
+    }
+}
+
+void GameEngine::flushLocation() {
+    if (locationPending_) {
+        locationPending_ = false;
+        displayCurrentLocation();
     }
 }
 
-void GameEngine::executeCommand(const CommandParser::Command& command) {
+void GameEngine::beginTurn() {
+    // Everything the previous turn put in the arena is dead by now
+    turnArena_.release();
+    output_.clear();
+    turn_ = TurnResult{};
+}
+
+GameEngine::TurnResult GameEngine::finishTurn() {
+    if (turn_.worldChanged) {
+        ++worldVersion_;
+    }
+    turn_.output = output_.view();
+    return turn_;
+}
+
+bool GameEngine::executeCommand(const CommandParser::Command& command) {
     try {
-        if (command.action == "quit") {
-            stop();
-            return;
-        }
+        CommandParser::Command resolved = command;
+        const auto* verb = Verbs::kTable.find(command.action);
 
-        // Handle movement commands
-        if (command.action == "go" || command.action == "move") {
-            handleMovement(command);
-            return;
-        }
+        // A bare direction means "go" that way. Single letters are always
+        // directions ("e" is east, not examine); longer prefixes only count
+        // when they do not start a verb ("so" is solve, "sou" is south)
+        const DirectionName* direction = command.arguments.empty() ? findDirection(command.action) : nullptr;
+        bool exactDirection = direction && (command.action.size() == 1 || command.action == direction->name);
 
-        // Handle look commands
-        if (command.action == "look") {
-            displayCurrentLocation();
-            return;
+        // Otherwise accept any unambiguous abbreviation of a verb
+        if (!verb && !exactDirection) {
+            std::string_view word = Verbs::index().resolve(command.action, &turnArena_);
+            verb = word.empty() ? nullptr : Verbs::kTable.find(word);
         }
-
-        // Handle examine commands
-        if (command.action == "examine") {
-            handleExamine(command);
-            return;
+        if (!verb && direction) {
+            verb = Verbs::kTable.find("go");
+            resolved.arguments = std::span<const std::string_view>(&direction->name, 1);
+            resolved.noun = direction->name;
         }
 
-        // Handle item-related commands
-        if (command.action == "take" || command.action == "pickup") {
-            handlePickup(command);
-            return;
+        if (!verb) {
+            output_ << "Unknown command.";
+            std::string_view guess =
+                Verbs::index().suggest(command.action, typoAllowance(command.action), &turnArena_);
+            if (!guess.empty()) {
+                output_ << " Did you mean \"" << guess << "\"?";
+            }
+            output_ << " Type 'help' for available commands.\n";
+            return false;
         }
+        resolved.action = verb->name;
 
-        if (command.action == "drop") {
-            handleDrop(command);
-            return;
+        // Item verbs accept the start of any word of a visible name, for
+        // both objects
+        if (verb->usage.starts_with("[item]") &&
+            !(resolveName(resolved.noun, resolved.object) &&
+              resolveName(resolved.indirect, resolved.indirectObject))) {
+            return false;
         }
 
-        if (command.action == "inventory" || command.action == "inv") {
-            displayInventory();
-            return;
+        return verb->handler(*this, resolved);
+    } catch (const std::exception& e) {
+        output_ << "Error executing command: " << e.what() << "\n";
+        return false;
+    }
+}
+
+bool GameEngine::resolveName(std::string_view& phrase, Symbol& symbol) {
+    if (phrase.empty()) {
+        return true;
+    }
+
+    std::string_view name = nouns_.resolve(phrase, &turnArena_);
+    if (!name.empty()) {
+        phrase = name;
+        symbol = SymbolTable::global().find(name);
+    } else if (std::string_view guess = nouns_.suggest(phrase, typoAllowance(phrase), &turnArena_);
+               !guess.empty()) {
+        output_ << "There is no \"" << phrase << "\" here. Did you mean \"" << guess << "\"?\n";
+        return false;
+    }
+    return true;
+}
+
+GameEngine::Completions GameEngine::complete(std::string_view prefix) {
+    completions_.clear();
+    Completions result;
+    Location* location = gameWorld_ ? gameWorld_->getCurrentLocation() : nullptr;
+    if (!running_ || !location || dialog_.isActive()) {
+        return result;
+    }
+
+    auto addExits = [&](std::string_view typed) {
+        for (const auto& direction : kDirections) {
+            if (location->getExit(direction.direction) && startsWithTyped(direction.name, typed)) {
+                completions_.push_back(direction.name);
+            }
         }
+    };
 
-        if (command.action == "use") {
-            handleUse(command);
-            return;
+    size_t start = std::min(prefix.find_first_not_of(' '), prefix.size());
+    size_t verbEnd = prefix.find(' ', start);
+    if (verbEnd == std::string_view::npos) {
+        // Verbs in help order, then exits, which also work as bare verbs
+        std::string_view typed = prefix.substr(start);
+        for (const auto& verb : Verbs::kList) {
+            forEachWord(verb, [&](std::string_view word) {
+                if (startsWithTyped(word, typed)) {
+                    completions_.push_back(word);
+                }
+            });
         }
+        addExits(typed);
+        result.replaceFrom = start;
+        result.candidates = completions_;
+        return result;
+    }
 
-        // Handle help command
-        if (command.action == "help") {
-            displayHelp();
-            return;
+    std::string_view word = prefix.substr(start, verbEnd - start);
+    const auto* verb = Verbs::kTable.find(word);
+    if (!verb) {
+        std::string_view name = Verbs::index().resolve(word);
+        verb = name.empty() ? nullptr : Verbs::kTable.find(name);
+    }
+    if (!verb) {
+        return result;
+    }
+
+    // Complete the object being typed: the words after the verb, or after
+    // the last preposition, less a leading article
+    size_t objectStart = std::min(prefix.find_first_not_of(' ', verbEnd), prefix.size());
+    for (size_t offset = objectStart, space; (space = prefix.find(' ', offset)) != std::string_view::npos;
+         offset = space + 1) {
+        std::string_view typed = prefix.substr(offset, space - offset);
+        if (CommandParser::isPreposition(typed) || (offset == objectStart && CommandParser::isArticle(typed))) {
+            objectStart = space + 1;
         }
+    }
+    std::string_view typed = prefix.substr(objectStart);
 
-        std::cout << "Unknown command. Type 'help' for available commands.\n";
-    } catch (const std::exception& e) {
-        std::cerr << "Error executing command: " << e.what() << std::endl;
+    if (verb->usage == "[direction]") {
+        addExits(typed);
+    } else if (verb->usage.starts_with("[item]")) {
+        nouns_.complete(typed, completions_);
     }
+    result.replaceFrom = objectStart;
+    result.candidates = completions_;
+    return result;
 }
 
-void GameEngine::handleMovement(const CommandParser::Command& command) {
-    if (command.arguments.empty()) {
-        std::cout << "Go where? Please specify a direction (north, south, east, west).\n";
-        return;
+void GameEngine::indexLocation(const Location* location, bool visible) {
+    if (!location) return;
+    for (const auto& item : location->getItems()) {
+        visible ? nouns_.insert(item->getName()) : nouns_.erase(item->getName());
+    }
+    for (const auto& npc : location->getNPCs()) {
+        visible ? nouns_.insert(npc->getName()) : nouns_.erase(npc->getName());
+    }
+}
+
+void GameEngine::rebuildNameIndex() {
+    nouns_.clear();
+    if (!gameWorld_ || !currentPlayer_) return;
+    indexLocation(gameWorld_->getCurrentLocation(), true);
+    for (const auto& item : currentPlayer_->getInventory()) {
+        nouns_.insert(item->getName());
     }
+}
 
-    const std::string& direction = command.arguments[0];
-    Location::Direction dir;
+bool GameEngine::handleMovement(const CommandParser::Command& command) {
+    // "go north" or "go to north"
+    std::string_view where = command.noun.empty() ? command.indirect : command.noun;
+    if (where.empty()) {
+        output_ << "Go where? Please specify a direction (north, south, east, west).\n";
+        return false;
+    }
 
     // Convert string direction to enum
-    if (direction == "north") dir = Location::Direction::NORTH;
-    else if (direction == "south") dir = Location::Direction::SOUTH;
-    else if (direction == "east") dir = Location::Direction::EAST;
-    else if (direction == "west") dir = Location::Direction::WEST;
-    else {
-        std::cout << "Invalid direction. Please use: north, south, east, or west.\n";
-        return;
+    const DirectionName* direction = findDirection(where);
+    if (!direction) {
+        output_ << "Invalid direction. Please use: north, south, east, or west.\n";
+        return false;
     }
 
     // Attempt movement
-    if (gameWorld_->move(dir)) {
-        std::cout << "You move " << direction << ".\n";
-        displayCurrentLocation();
-    } else {
-        std::cout << "You cannot go that way.\n";
+    Location* previous = gameWorld_->getCurrentLocation();
+    uint64_t layout = gameWorld_->getLayoutVersion();
+    if (gameWorld_->move(direction->direction)) {
+        turn_.locationChanged = true;
+        // Arriving next to an environment builds it, adding exits views may
+        // lack, and walking the wilds generates and evicts chunks, whose
+        // freed rooms' addresses may come back as other rooms
+        turn_.worldChanged = turn_.worldChanged || gameWorld_->getLayoutVersion() != layout;
+        indexLocation(previous, false);
+        indexLocation(gameWorld_->getCurrentLocation(), true);
+        output_ << "You move " << direction->name << ".\n";
+        showLocation();
+        return true;
     }
+
+    output_ << "You cannot go that way.\n";
+    return false;
 }
 
-void GameEngine::handleExamine(const CommandParser::Command& command) {
-    if (command.arguments.empty()) {
-        std::cout << "What would you like to examine?\n";
-        return;
+bool GameEngine::handleExamine(const CommandParser::Command& command) {
+    if (command.noun.empty()) {
+        output_ << "What would you like to examine?\n";
+        return false;
     }
 
     Location* currentLoc = gameWorld_->getCurrentLocation();
     if (!currentLoc) {
-        std::cout << "Error: Cannot examine items in invalid location.\n";
-        return;
-    }
-
-    // Combine remaining arguments for multi-word items
-    std::string itemName;
-    for (size_t i = 0; i < command.arguments.size(); ++i) {
-        itemName += command.arguments[i];
-        if (i < command.arguments.size() - 1) itemName += " ";
+        output_ << "Error: Cannot examine items in invalid location.\n";
+        return false;
     }
 
     // Check inventory first
-    auto inventoryItem = currentPlayer_->getItem(itemName);
+    auto inventoryItem = currentPlayer_->getItem(command.object);
     if (inventoryItem) {
-        std::cout << inventoryItem->getDescription() << "\n";
-        return;
+        displayItemDescription(*inventoryItem);
+        return true;
     }
 
     // Check location items
-    const auto& items = currentLoc->getItems();
-    auto it = std::find_if(items.begin(), items.end(),
-        [&itemName](const std::shared_ptr<Item>& item) {
-            return item->getName() == itemName;
-        });
-
-    if (it != items.end()) {
-        std::cout << (*it)->getDescription() << "\n";
-        return;
+    if (auto item = currentLoc->getItem(command.object)) {
+        displayItemDescription(*item);
+        return true;
     }
 
     // Check NPCs
-    const auto& npcs = currentLoc->getNPCs();
-    auto npcIt = std::find_if(npcs.begin(), npcs.end(),
-        [&itemName](const std::shared_ptr<NPC>& npc) {
-            return npc->getName() == itemName;
-        });
-
-    if (npcIt != npcs.end()) {
-        std::cout << (*npcIt)->getDescription() << "\n";
-        return;
+    if (auto npc = currentLoc->getNPC(command.object)) {
+        output_ << npc->getDescription() << "\n";
+        return true;
     }
 
-    std::cout << "You don't see that here.\n";
+    output_ << "You don't see that here.\n";
+    return false;
 }
 
-void GameEngine::handlePickup(const CommandParser::Command& command) {
-    if (command.arguments.empty()) {
-        std::cout << "What would you like to take?\n";
-        return;
+bool GameEngine::handlePickup(const CommandParser::Command& command) {
+    if (command.noun.empty()) {
+        output_ << "What would you like to take?\n";
+        return false;
     }
 
     Location* currentLoc = gameWorld_->getCurrentLocation();
     if (!currentLoc) {
-        std::cout << "Error: Cannot take items in invalid location.\n";
-        return;
+        output_ << "Error: Cannot take items in invalid location.\n";
+        return false;
     }
 
-    // Combine multi-word item names and convert to lowercase for comparison
-    std::string itemName;
-    for (size_t i = 0; i < command.arguments.size(); ++i) {
-        itemName += command.arguments[i];
-        if (i < command.arguments.size() - 1) itemName += " ";
-    }
-
-    // Debug information
-    std::cout << "Debug: Looking for item '" << itemName << "'\n";
-    const auto& items = currentLoc->getItems();
-    std::cout << "Debug: Location has " << items.size() << " items:\n";
-    for (const auto& item : items) {
-        std::cout << "Debug: Found '" << item->getName() << "' in location\n";
-    }
-
-    // Convert item name to lowercase for case-insensitive comparison
-    std::string lowerItemName = itemName;
-    std::transform(lowerItemName.begin(), lowerItemName.end(), 
-                  lowerItemName.begin(), ::tolower);
-
     // Find the item in the current location
-    auto it = std::find_if(items.begin(), items.end(),
-        [&lowerItemName](const std::shared_ptr<Item>& item) {
-            std::string itemNameLower = item->getName();
-            std::transform(itemNameLower.begin(), itemNameLower.end(), 
-                         itemNameLower.begin(), ::tolower);
-            return itemNameLower == lowerItemName;
-        });
-
-    if (it != items.end()) {
-        if (currentPlayer_->addItem(*it)) {
-            if (currentLoc->removeItem((*it)->getName())) {
-                std::cout << "Taken: " << (*it)->getName() << "\n";
-            } else {
-                std::cout << "Error: Failed to remove item from location\n";
-                currentPlayer_->removeItem((*it)->getName()); // Rollback
+    if (auto item = currentLoc->getItem(command.object)) {
+        if (currentPlayer_->addItem(item)) {
+            if (currentLoc->removeItem(item->getSymbol())) {
+                turn_.inventoryChanged = true;
+                turn_.worldChanged = true;
+                // Location and inventory are both visible, so nouns_ is unchanged
+                output_ << "Taken: " << item->getName() << "\n";
+                return true;
             }
+            output_ << "Error: Failed to remove item from location\n";
+            currentPlayer_->removeItem(item->getSymbol()); // Rollback
         } else {
-            std::cout << "You can't carry any more items.\n";
+            output_ << "You can't carry any more items.\n";
         }
     } else {
-        std::cout << "You don't see that here.\n";
+        output_ << "You don't see that here.\n";
     }
+    return false;
 }
 
-void GameEngine::handleDrop(const CommandParser::Command& command) {
-    if (command.arguments.empty()) {
-        std::cout << "What would you like to drop?\n";
-        return;
+bool GameEngine::handleDrop(const CommandParser::Command& command) {
+    if (command.noun.empty()) {
+        output_ << "What would you like to drop?\n";
+        return false;
     }
 
     Location* currentLoc = gameWorld_->getCurrentLocation();
     if (!currentLoc) {
-        std::cout << "Error: Cannot drop items in invalid location.\n";
-        return;
-    }
-
-    // Combine multi-word item names
-    std::string itemName;
-    for (size_t i = 0; i < command.arguments.size(); ++i) {
-        itemName += command.arguments[i];
-        if (i < command.arguments.size() - 1) itemName += " ";
+        output_ << "Error: Cannot drop items in invalid location.\n";
+        return false;
     }
 
     // Find the item in player's inventory
-    auto item = currentPlayer_->getItem(itemName);
+    auto item = currentPlayer_->getItem(command.object);
     if (item) {
         currentLoc->addItem(item);
-        currentPlayer_->removeItem(itemName);
-        std::cout << "Dropped: " << itemName << "\n";
-    } else {
-        std::cout << "You don't have that item.\n";
+        currentPlayer_->removeItem(item->getSymbol());
+        turn_.inventoryChanged = true;
+        turn_.worldChanged = true;
+        // Location and inventory are both visible, so nouns_ is unchanged
+        output_ << "Dropped: " << item->getName() << "\n";
+        return true;
     }
+
+    output_ << "You don't have that item.\n";
+    return false;
 }
 
-void GameEngine::handleUse(const CommandParser::Command& command) {
-    if (command.arguments.empty()) {
-        std::cout << "What would you like to use?\n";
-        return;
+bool GameEngine::handleUse(const CommandParser::Command& command) {
+    if (command.noun.empty()) {
+        output_ << "What would you like to use?\n";
+        return false;
     }
 
-    // Combine multi-word item names
-    std::string itemName;
-    for (size_t i = 0; i < command.arguments.size(); ++i) {
-        itemName += command.arguments[i];
-        if (i < command.arguments.size() - 1) itemName += " ";
+    auto item = currentPlayer_->getItem(command.object);
+    if (!item) {
+        output_ << "You don't have that item.\n";
+        return false;
     }
 
-    auto item = currentPlayer_->getItem(itemName);
-    if (!item) {
-        std::cout << "You don't have that item.\n";
-        return;
+    // "use X on Y": Y must be at hand, and an NPC may react to X
+    if (!command.preposition.empty()) {
+        Location* currentLoc = gameWorld_->getCurrentLocation();
+        auto npc = currentLoc ? currentLoc->getNPC(command.indirectObject) : nullptr;
+        if (npc && npc->canInteractWith(item->GetItemId())) {
+            output_ << npc->getItemInteraction(item->GetItemId()) << "\n";
+            return true;
+        }
+        bool present = npc || currentPlayer_->hasItem(command.indirectObject) ||
+                       (currentLoc && currentLoc->getItem(command.indirectObject));
+        if (!present) {
+            output_ << "You don't see that here.\n";
+            return false;
+        }
     }
 
     // Try to cast to UsableItem
     auto usableItem = std::dynamic_pointer_cast<UsableItem>(item);
     if (!usableItem) {
-        std::cout << "You can't use that item.\n";
-        return;
+        output_ << "You can't use that item.\n";
+        return false;
     }
 
     if (usableItem->CanUse()) {
-        std::cout << usableItem->Use() << "\n";
+        output_ << usableItem->Use() << "\n";
+        return true;
+    }
+
+    output_ << "You can't use that item here.\n";
+    return false;
+}
+
+bool GameEngine::handleGive(const CommandParser::Command& command) {
+    if (command.noun.empty()) {
+        output_ << "What would you like to give?\n";
+        return false;
+    }
+
+    auto item = currentPlayer_->getItem(command.object);
+    if (!item) {
+        output_ << "You don't have that item.\n";
+        return false;
+    }
+
+    if (command.indirect.empty()) {
+        output_ << "Give the " << item->getName() << " to whom?\n";
+        return false;
+    }
+
+    Location* currentLoc = gameWorld_->getCurrentLocation();
+    auto npc = currentLoc ? currentLoc->getNPC(command.indirectObject) : nullptr;
+    if (!npc) {
+        output_ << "You don't see that here.\n";
+        return false;
+    }
+
+    if (!npc->canInteractWith(item->GetItemId())) {
+        output_ << npc->getName() << " has no use for the " << item->getName() << ".\n";
+        return false;
+    }
+
+    // The NPC keeps the item, so it leaves the world
+    currentPlayer_->removeItem(item->getSymbol());
+    nouns_.erase(item->getName());
+    turn_.inventoryChanged = true;
+    turn_.worldChanged = true;
+    output_ << npc->getItemInteraction(item->GetItemId()) << "\n";
+    return true;
+}
+
+bool GameEngine::handleSolve(const CommandParser::Command& /* command */) {
+    Location* currentLoc = gameWorld_->getCurrentLocation();
+    auto puzzle = currentLoc ? currentLoc->getPuzzle() : nullptr;
+    if (!puzzle) {
+        output_ << "There is no puzzle here.\n";
+        return false;
+    }
+
+    if (puzzle->IsSolved()) {
+        output_ << "You have already solved " << puzzle->GetName() << ".\n";
+        return false;
+    }
+
+    if (auto riddle = std::dynamic_pointer_cast<RiddlePuzzle>(puzzle)) {
+        startDialog(riddleDialog(riddle));
+    } else if (auto reflection = std::dynamic_pointer_cast<ReflectionPuzzle>(puzzle)) {
+        startDialog(reflectionDialog(reflection));
+    } else if (auto books = std::dynamic_pointer_cast<BookSortingPuzzle>(puzzle)) {
+        startDialog(bookSortingDialog(books));
     } else {
-        std::cout << "You can't use that item here.\n";
+        output_ << "You are not sure how to approach " << puzzle->GetName() << ".\n";
+        return false;
+    }
+    return true;
+}
+
+void GameEngine::startDialog(SessionTask dialog) {
+    // The dialog's prompt must follow the view of the room it happens in
+    flushLocation();
+    dialog_ = std::move(dialog);
+    dialog_.start();
+    if (!dialog_.isActive()) {
+        dialog_.reset();
+    }
+}
+
+SessionTask GameEngine::riddleDialog(std::shared_ptr<RiddlePuzzle> puzzle) {
+    output_ << puzzle->GetName() << ":\n" << puzzle->GetDescription() << "\n";
+
+    while (puzzle->CanAttempt()) {
+        output_ << "\nYour answer ('hint' for a hint, 'leave' to stop): ";
+        std::pmr::string answer = normalizeReply(co_await dialogInput_.next(), &turnArena_);
+
+        if (answer == "leave") {
+            output_ << "You step away from the riddle.\n";
+            co_return;
+        }
+        if (answer == "hint") {
+            std::string_view hint = puzzle->GetHint();
+            output_ << (hint.empty() ? "No hint is offered." : hint) << "\n";
+            continue;
+        }
+
+        turn_.worldChanged = true;
+        if (puzzle->AttemptSolution(answer)) {
+            output_ << "Correct! You have solved " << puzzle->GetName() << ".\n";
+            co_return;
+        }
+
+        output_ << "That is not the answer.";
+        if (puzzle->GetAttemptsRemaining() > 0) {
+            output_ << " Attempts remaining: " << puzzle->GetAttemptsRemaining();
+        }
+        output_ << "\n";
+    }
+
+    output_ << "The riddle can no longer be answered.\n";
+}
+
+SessionTask GameEngine::reflectionDialog(std::shared_ptr<ReflectionPuzzle> puzzle) {
+    puzzle->SetHasLens(currentPlayer_->getItem("Crystal Lens") != nullptr);
+
+    output_ << puzzle->GetName() << ":\n" << puzzle->GetDescription() << "\n"
+            << "Commands: place X Y ANGLE, rotate X Y DEGREES, remove X Y, beam, try, leave\n";
+
+    while (true) {
+        output_ << "\nMirrors> ";
+        ReplyStream reply(normalizeReply(co_await dialogInput_.next(), &turnArena_));
+        std::pmr::string action(&turnArena_);
+        int x = 0, y = 0, angle = 0;
+        reply >> action;
+
+        if (action == "leave") {
+            output_ << "You leave the mirrors as they are.\n";
+            co_return;
+        } else if (action == "place" && reply >> x >> y >> angle) {
+            bool placed = puzzle->PlaceMirror(x, y, angle);
+            turn_.worldChanged = turn_.worldChanged || placed;
+            output_ << (placed ? "Mirror placed.\n" : "You cannot place a mirror there.\n");
+        } else if (action == "rotate" && reply >> x >> y >> angle) {
+            bool rotated = puzzle->RotateMirror(x, y, angle);
+            turn_.worldChanged = turn_.worldChanged || rotated;
+            output_ << (rotated ? "Mirror rotated.\n" : "There is no mirror there.\n");
+        } else if (action == "remove" && reply >> x >> y) {
+            bool removed = puzzle->RemoveMirror(x, y);
+            turn_.worldChanged = turn_.worldChanged || removed;
+            output_ << (removed ? "Mirror removed.\n" : "There is no mirror there.\n");
+        } else if (action == "beam") {
+            output_ << "The light travels through:";
+            for (const auto& [bx, by] : puzzle->GetBeamPath()) {
+                output_ << " (" << bx << "," << by << ")";
+            }
+            output_ << "\n";
+        } else if (action == "try") {
+            if (!puzzle->CanAttempt()) {
+                output_ << puzzle->GetHint() << "\n";
+                continue;
+            }
+            turn_.worldChanged = true;
+            if (puzzle->AttemptSolution("")) {
+                output_ << "The beam strikes the ancient lock. You have solved "
+                        << puzzle->GetName() << ".\n";
+                co_return;
+            }
+            output_ << "The light falls short. " << puzzle->GetHint() << "\n";
+        } else {
+            output_ << "Commands: place X Y ANGLE, rotate X Y DEGREES, remove X Y, beam, try, leave\n";
+        }
     }
 }
 
+SessionTask GameEngine::bookSortingDialog(std::shared_ptr<BookSortingPuzzle> puzzle) {
+    output_ << puzzle->GetName() << ":\n" << puzzle->GetDescription() << "\nBooks:\n";
+    for (const auto& book : puzzle->GetAvailableBooks()) {
+        output_ << "- " << book->GetId() << ": " << book->GetTitle()
+                << " (\"" << book->GetInscription() << "\")\n";
+    }
+    output_ << "Commands: place BOOK SLOT, remove SLOT, shelf, try, hint, leave\n";
+
+    while (puzzle->CanAttempt()) {
+        output_ << "\nShelf> ";
+        ReplyStream reply(std::pmr::string(co_await dialogInput_.next(), &turnArena_));
+        std::pmr::string action(&turnArena_);
+        std::pmr::string bookId(&turnArena_);
+        size_t slot = 0;
+        reply >> action;
+        foldCase(action);
+
+        if (action == "leave") {
+            output_ << "You step back from the shelf.\n";
+            co_return;
+        } else if (action == "place" && reply >> bookId >> slot) {
+            if (slot < 1 || slot > puzzle->GetTotalPositions()) {
+                output_ << "Slots are numbered 1 to " << puzzle->GetTotalPositions() << ".\n";
+                continue;
+            }
+            std::transform(bookId.begin(), bookId.end(), bookId.begin(),
+                           [](unsigned char c) { return std::toupper(c); });
+            bool placed = puzzle->PlaceBook(std::string(bookId), slot - 1);
+            turn_.worldChanged = turn_.worldChanged || placed;
+            output_ << (placed ? "Book placed.\n" : "That book cannot go there.\n");
+        } else if (action == "remove" && reply >> slot) {
+            if (slot < 1 || slot > puzzle->GetTotalPositions()) {
+                output_ << "Slots are numbered 1 to " << puzzle->GetTotalPositions() << ".\n";
+                continue;
+            }
+            std::string removed = puzzle->RemoveBook(slot - 1);
+            turn_.worldChanged = turn_.worldChanged || !removed.empty();
+            if (removed.empty()) {
+                output_ << "That slot is empty.\n";
+            } else {
+                output_ << "Removed " << removed << ".\n";
+            }
+        } else if (action == "shelf") {
+            auto arrangement = puzzle->GetCurrentArrangement();
+            for (size_t i = 0; i < arrangement.size(); ++i) {
+                output_ << (i + 1) << ": "
+                        << (arrangement[i].empty() ? "(empty)" : arrangement[i]) << "\n";
+            }
+        } else if (action == "hint") {
+            output_ << puzzle->GetHint() << "\n";
+        } else if (action == "try") {
+            turn_.worldChanged = true;
+            if (puzzle->AttemptSolution()) {
+                output_ << "The shelf clicks into place. You have solved "
+                        << puzzle->GetName() << ".\n";
+                co_return;
+            }
+            output_ << "Nothing happens. The order must be wrong.\n";
+        } else {
+            output_ << "Commands: place BOOK SLOT, remove SLOT, shelf, try, hint, leave\n";
+        }
+    }
+
+    output_ << "The shelf locks. The books can no longer be rearranged.\n";
+}
+
 void GameEngine::displayInventory() {
-    std::cout << "\n=== Inventory ===\n";
-    std::string inventoryDesc = currentPlayer_->getInventoryDescription();
+    output_ << "\n=== Inventory ===\n";
+    std::pmr::string inventoryDesc = currentPlayer_->getInventoryDescription(&turnArena_);
     if (inventoryDesc.empty()) {
-        std::cout << "Your inventory is empty.\n";
+        output_ << "Your inventory is empty.\n";
     } else {
-        std::cout << inventoryDesc << "\n";
+        output_ << inventoryDesc << "\n";
     }
 }
 
 void GameEngine::displayCurrentLocation() {
     Location* currentLoc = gameWorld_->getCurrentLocation();
     if (!currentLoc) {
-        std::cout << "Error: Invalid location!\n";
+        output_ << "Error: Invalid location!\n";
+        return;
+    }
+
+    // A view rendered while waiting for input is exact unless something
+    // changed since, including earlier in this turn
+    if (!turn_.worldChanged) {
+        uint64_t contentVersion = getContentVersion();
+        for (const auto& prerendered : neighbourViews_) {
+            if (prerendered.location == currentLoc && prerendered.worldVersion == worldVersion_ &&
+                prerendered.contentVersion == contentVersion) {
+                output_ << prerendered.text.view();
+                return;
+            }
+        }
+    }
+    renderLocation(*currentLoc, output_);
+}
+
+void GameEngine::prerender() {
+    Location* currentLoc = gameWorld_ ? gameWorld_->getCurrentLocation() : nullptr;
+    if (!running_ || !currentLoc || dialog_.isActive()) {
         return;
     }
 
+    // Build the environments the player may walk into next; their exits
+    // change the rooms at the border, so older views are stale
+    if (gameWorld_->prefetch()) {
+        ++worldVersion_;
+    }
+
+    // Read the version first: content published meanwhile makes the view
+    // look older than it is, never newer
+    uint64_t contentVersion = getContentVersion();
+    for (size_t i = 0; i < neighbourViews_.size(); ++i) {
+        PrerenderedView& prerendered = neighbourViews_[i];
+        const Location* neighbour = currentLoc->getExit(kDirections[i].direction);
+        if (!neighbour) {
+            prerendered.location = nullptr;
+            continue;
+        }
+        if (prerendered.location == neighbour && prerendered.worldVersion == worldVersion_ &&
+            prerendered.contentVersion == contentVersion) {
+            continue;
+        }
+
+        prerendered.text.clear();
+        renderLocation(*neighbour, prerendered.text);
+        prerendered.location = neighbour;
+        prerendered.worldVersion = worldVersion_;
+        prerendered.contentVersion = contentVersion;
+    }
+}
+
+uint64_t GameEngine::getContentVersion() const {
+    return content_ ? content_->getVersion() : 0;
+}
+
+void GameEngine::renderLocation(const Location& location, OutputBuffer& out) const {
+    // Published content replaces the built-in text; the reader keeps it
+    // alive until the view has been written even if a reload happens meanwhile
+    std::string_view name = location.getName();
+    std::string_view description = location.getDescription();
+    std::optional<ContentStore::Reader> content;
+    if (content_) {
+        content.emplace(*content_);
+        if (const auto* text = (*content)->findLocation(name)) {
+            name = text->name;
+            if (!text->description.empty()) {
+                description = text->description;
+            }
+        }
+    }
+
     // Display location header
-    std::cout << "\n" << std::string(50, '=') << "\n";
-    std::cout << std::setw(25) << currentLoc->getName() << "\n";
-    std::cout << std::string(50, '=') << "\n";
+    out << "\n";
+    out.repeat('=', 50) << "\n";
+    out.pad(name, 25) << "\n";
+    out.repeat('=', 50) << "\n";
 
     // Display description
-    std::cout << currentLoc->getDescription() << "\n\n";
+    out << description << "\n\n";
 
     // Display exits
-    std::cout << "Exits:";
-    if (currentLoc->getExit(Location::Direction::NORTH)) std::cout << " north";
-    if (currentLoc->getExit(Location::Direction::EAST)) std::cout << " east";
-    if (currentLoc->getExit(Location::Direction::SOUTH)) std::cout << " south";
-    if (currentLoc->getExit(Location::Direction::WEST)) std::cout << " west";
-    std::cout << "\n";
+    out << "Exits:";
+    if (location.hasExit(Location::Direction::NORTH)) out << " north";
+    if (location.hasExit(Location::Direction::EAST)) out << " east";
+    if (location.hasExit(Location::Direction::SOUTH)) out << " south";
+    if (location.hasExit(Location::Direction::WEST)) out << " west";
+    out << "\n";
 
     // Display items in location
-    const auto& items = currentLoc->getItems();
+    const auto& items = location.getItems();
     if (!items.empty()) {
-        std::cout << "\nYou see:";
+        out << "\nYou see:";
         for (const auto& item : items) {
-            std::cout << "\n- " << item->getName();
+            out << "\n- " << item->getName();
         }
-        std::cout << "\n";
+        out << "\n";
     }
 
     // Display NPCs in location
-    const auto& npcs = currentLoc->getNPCs();
+    const auto& npcs = location.getNPCs();
     if (!npcs.empty()) {
-        std::cout << "\nPresent here:";
+        out << "\nPresent here:";
         for (const auto& npc : npcs) {
-            std::cout << "\n- " << npc->getName();
+            out << "\n- " << npc->getName();
+        }
+        out << "\n";
+    }
+}
+
+void GameEngine::displayItemDescription(const Item& item) {
+    if (content_) {
+        ContentStore::Reader content(*content_);
+        if (const std::string* description = content->findItemDescription(item.getName())) {
+            output_ << *description << "\n";
+            return;
         }
-        std::cout << "\n";
     }
+    output_ << item.getDescription() << "\n";
 }
 
 void GameEngine::displayHelp() {
-    std::cout << "\n=== AVAILABLE COMMANDS ===\n\n"
-              << "Movement:\n"
-              << "  go [direction]  - Move in specified direction (north, south, east, west)\n"
-              << "  move [direction]- Alternative to 'go'\n\n"
-              << "Environment:\n"
-              << "  look           - Look around your current location\n"
-              << "  examine [item] - Look at a specific item or feature\n\n"
-              << "Item Management:\n"
-              << "  take/pickup [item] - Pick up an item\n"
-              << "  drop [item]    - Drop an item from your inventory\n"
-              << "  inventory/inv  - Show your inventory\n"
-              << "  use [item]     - Use an item\n\n"
-              << "System:\n"
-              << "  help           - Show this help message\n"
-              << "  quit           - Exit the game\n\n";
+    const auto& verbs = Verbs::kTable.getVerbs();
+
+    // Synopses read "name/alias [usage]" and are aligned on the widest one
+    auto synopsisLength = [](const Verb<Verbs::Handler>& verb) {
+        size_t length = verb.usage.empty() ? 0 : verb.usage.size() + 1;
+        forEachWord(verb, [&length](std::string_view word) { length += word.size() + 1; });
+        return length - 1;
+    };
+    size_t width = 0;
+    for (const auto& verb : verbs) {
+        width = std::max(width, synopsisLength(verb));
+    }
+
+    output_ << "\n=== AVAILABLE COMMANDS ===\n";
+    for (size_t i = 0; i < verbs.size(); ++i) {
+        // Categories are listed in the order they first appear in the table
+        std::string_view category = verbs[i].category;
+        bool seen = std::any_of(verbs.begin(), verbs.begin() + i,
+            [category](const auto& verb) { return verb.category == category; });
+        if (seen) continue;
+
+        output_ << "\n" << category << ":\n";
+        for (const auto& verb : verbs) {
+            if (verb.category != category) continue;
+
+            output_ << "  ";
+            const char* separator = "";
+            forEachWord(verb, [this, &separator](std::string_view word) {
+                output_ << separator << word;
+                separator = "/";
+            });
+            if (!verb.usage.empty()) output_ << " " << verb.usage;
+            output_.repeat(' ', width - synopsisLength(verb)) << " - " << verb.help << "\n";
+        }
+    }
+    output_ << "\n";
 }
 
 void GameEngine::displayWelcomeMessage() {
-    std::cout << "\n" << std::string(60, '*') << "\n"
-              << "Welcome to Eldoria: Shadows of Malakar\n"
-              << "A text adventure game\n"
-              << std::string(60, '*') << "\n\n"
-              << "Type 'help' for a list of commands.\n\n";
+    output_ << "\n";
+    output_.repeat('*', 60) << "\n";
+    output_ << "Welcome to Eldoria: Shadows of Malakar\n"
+            << "A text adventure game\n";
+    output_.repeat('*', 60) << "\n\n";
+    output_ << "Type 'help' for a list of commands.\n\n";
+}
+
+void GameEngine::saveSnapshot(const std::string& path) const {
+    if (!gameWorld_ || !currentPlayer_) {
+        throw std::runtime_error("Cannot save a game that has not started");
+    }
+    Snapshot::save(*gameWorld_, *currentPlayer_, path);
+}
+
+void GameEngine::loadSnapshot(const std::string& path) {
+    // Restore into a fresh session so a bad file leaves the current one intact
+    auto world = std::make_unique<GameWorld>();
+    auto player = createPlayer();
+    Snapshot::load(*world, *player, path);
+
+    gameWorld_ = std::move(world);
+    currentPlayer_ = std::move(player);
+    ++worldVersion_;
+    dialog_.reset();
+    rebuildNameIndex();
+    running_ = true;
+}
+
+size_t GameEngine::openJournal(const std::string& directory, size_t checkpointInterval) {
+    CommandJournal::Recovery recovery = CommandJournal::recover(directory);
+    auto journal = std::make_unique<CommandJournal>(directory, recovery);
+
+    journal_.reset();
+    if (recovery.checkpoint > 0) {
+        loadSnapshot(journal->checkpointPath(recovery.checkpoint));
+    } else {
+        beginTurn();
+        openGame();
+        dialog_.reset();
+    }
+    for (const auto& command : recovery.commands) {
+        step(command);
+    }
+
+    journal_ = std::move(journal);
+    checkpointInterval_ = checkpointInterval == 0 ? 1 : checkpointInterval;
+    return recovery.commands.size();
+}
+
+void GameEngine::commitJournal() {
+    if (journal_) {
+        journal_->commit();
+    }
 }
 
 void GameEngine::stop() {
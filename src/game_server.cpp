@@ -0,0 +1,494 @@
+#include "game_server.h"
+#include "text_scan.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const char* const kPrompt = "\n> ";
+const int kMaxEvents = 256;
+const size_t kReadChunk = 4096;
+const size_t kTurnsPerSlice = 8;  // turns a task runs before yielding its worker
+
+std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+}  // namespace
+
+GameServer::GameServer(const Options& options)
+    : options_(options),
+      epollFd_(-1),
+      wakeFd_(-1),
+      unixListenFd_(-1),
+      tcpListenFd_(-1),
+      stopRequested_(false),
+      reloadRequested_(false) {
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd_ < 0) {
+        throw systemError("epoll_create1");
+    }
+
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd_ < 0) {
+        throw systemError("eventfd");
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wakeFd_;
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &event);
+
+    if (!options_.unixPath.empty()) {
+        listenUnix();
+    }
+    if (options_.tcpPort > 0) {
+        listenTcp();
+    }
+    if (unixListenFd_ < 0 && tcpListenFd_ < 0) {
+        throw std::runtime_error("GameServer needs a Unix socket path or a TCP port");
+    }
+
+    scheduler_ = std::make_unique<TurnScheduler>(options_.workerThreads);
+}
+
+GameServer::~GameServer() {
+    // Let in-flight turns finish before their sessions go away; they may
+    // still queue follow-up work, so the scheduler must stay reachable
+    scheduler_->shutdown();
+
+    for (auto& entry : sessions_) {
+        close(entry.first);
+    }
+    sessions_.clear();
+
+    if (unixListenFd_ >= 0) {
+        close(unixListenFd_);
+        unlink(options_.unixPath.c_str());
+    }
+    if (tcpListenFd_ >= 0) close(tcpListenFd_);
+    if (wakeFd_ >= 0) close(wakeFd_);
+    if (epollFd_ >= 0) close(epollFd_);
+}
+
+void GameServer::listenUnix() {
+    sockaddr_un addr{};
+    if (options_.unixPath.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Unix socket path too long: " + options_.unixPath);
+    }
+
+    unixListenFd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (unixListenFd_ < 0) {
+        throw systemError("socket");
+    }
+
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, options_.unixPath.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(options_.unixPath.c_str());
+
+    if (bind(unixListenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(unixListenFd_, SOMAXCONN) < 0) {
+        throw systemError("listen on " + options_.unixPath);
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = unixListenFd_;
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, unixListenFd_, &event);
+}
+
+void GameServer::listenTcp() {
+    tcpListenFd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (tcpListenFd_ < 0) {
+        throw systemError("socket");
+    }
+
+    int reuse = 1;
+    setsockopt(tcpListenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // Only localhost: the protocol has no authentication
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(options_.tcpPort));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(tcpListenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(tcpListenFd_, SOMAXCONN) < 0) {
+        throw systemError("listen on port " + std::to_string(options_.tcpPort));
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = tcpListenFd_;
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, tcpListenFd_, &event);
+}
+
+void GameServer::run() {
+    epoll_event events[kMaxEvents];
+
+    while (!stopRequested_.load()) {
+        int count = epoll_wait(epollFd_, events, kMaxEvents, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            throw systemError("epoll_wait");
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+
+            if (fd == wakeFd_) {
+                uint64_t value;
+                while (read(wakeFd_, &value, sizeof(value)) > 0) {}
+                if (reloadRequested_.exchange(false)) {
+                    reloadContent();
+                }
+                drainReady();
+                continue;
+            }
+
+            if (fd == unixListenFd_ || fd == tcpListenFd_) {
+                acceptConnections(fd);
+                continue;
+            }
+
+            auto it = sessions_.find(fd);
+            if (it == sessions_.end()) continue;
+            SessionPtr session = it->second;
+
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeSession(*session);
+                continue;
+            }
+            if (events[i].events & EPOLLIN) {
+                handleReadable(session);
+            }
+            if (events[i].events & EPOLLOUT) {
+                flushOutput(*session);
+            }
+            finishEvent(session);
+        }
+    }
+}
+
+void GameServer::stop() {
+    // Lock-free atomics and write() on an eventfd are async-signal-safe
+    stopRequested_.store(true);
+    uint64_t one = 1;
+    ssize_t ignored = write(wakeFd_, &one, sizeof(one));
+    (void)ignored;
+}
+
+void GameServer::requestReload() {
+    reloadRequested_.store(true);
+    uint64_t one = 1;
+    ssize_t ignored = write(wakeFd_, &one, sizeof(one));
+    (void)ignored;
+}
+
+void GameServer::reloadContent() {
+    if (!options_.content || options_.contentPath.empty()) {
+        return;
+    }
+    try {
+        options_.content->publish(WorldContent::load(options_.contentPath));
+        std::cerr << "Reloaded world content from " << options_.contentPath << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Keeping current world content: " << e.what() << "\n";
+    }
+}
+
+void GameServer::acceptConnections(int listenFd) {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            // EAGAIN: backlog drained; anything else: drop this attempt
+            return;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+
+        // Building the world is real work, so the opening text comes from a worker too
+        auto session = std::make_shared<Session>(fd);
+        session->engine.setContentStore(options_.content);
+        sessions_[fd] = session;
+        schedule(session);
+    }
+}
+
+void GameServer::handleReadable(const SessionPtr& session) {
+    char buffer[kReadChunk];
+    std::vector<PendingLine> lines;
+    bool peerClosed = false;
+
+    while (true) {
+        ssize_t received = read(session->fd, buffer, sizeof(buffer));
+        if (received < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) peerClosed = true;
+            break;
+        }
+        if (received == 0) {
+            // Peer finished sending; answer what is already framed, then close
+            peerClosed = true;
+            break;
+        }
+        session->received.append(buffer, static_cast<size_t>(received));
+
+        // Frame complete lines
+        size_t start = 0;
+        size_t newline;
+        while ((newline = findByte(session->received, '\n', start)) != std::string::npos) {
+            size_t end = newline;
+            if (end > start && session->received[end - 1] == '\r') --end;
+
+            if (session->discarding) {
+                session->discarding = false;
+            } else if (end - start > options_.maxLineLength) {
+                lines.push_back({std::string(), true});
+            } else {
+                lines.push_back({session->received.substr(start, end - start), false});
+            }
+            start = newline + 1;
+        }
+        session->received.erase(0, start);
+
+        if (session->received.size() > options_.maxLineLength) {
+            session->received.clear();
+            session->discarding = true;
+            // Answer in order with the turns already framed
+            lines.push_back({std::string(), true});
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        for (auto& line : lines) {
+            session->pending.push_back(std::move(line));
+        }
+        session->peerClosed = session->peerClosed || peerClosed;
+    }
+    if (!lines.empty()) {
+        schedule(session);
+    }
+}
+
+void GameServer::schedule(const SessionPtr& session) {
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        if (session->scheduled) return;
+        session->scheduled = true;
+    }
+    scheduler_->submit([this, session] { runSession(session); });
+}
+
+void GameServer::runSession(const SessionPtr& session) {
+    bool yielded = true;
+    bool waiting = false;
+    try {
+        if (!session->started) {
+            session->started = true;
+            session->play = playSession(*session);
+            session->play.start();
+        }
+
+        for (size_t turn = 0; turn < kTurnsPerSlice; ++turn) {
+            PendingLine line;
+            {
+                std::lock_guard<std::mutex> lock(session->mutex);
+                if (session->pending.empty() || session->quit) {
+                    waiting = !session->quit;
+                    session->pending.clear();
+                    session->scheduled = false;
+                    yielded = false;
+                    break;
+                }
+                line = std::move(session->pending.front());
+                session->pending.pop_front();
+            }
+
+            if (line.tooLong) {
+                emit(*session, "Input line too long.", true);
+            } else {
+                session->lines.deliver(std::move(line.text));
+                session->play.rethrowIfFailed();
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error running session: " << e.what() << std::endl;
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->quit = true;
+        session->pending.clear();
+        session->scheduled = false;
+        yielded = false;
+    }
+
+    notifyReady(session);
+
+    // Still have work: yield the worker so one busy session cannot monopolise it
+    if (yielded) {
+        scheduler_->requeue([this, session] { runSession(session); });
+    } else if (waiting) {
+        prerender(session);
+    }
+}
+
+void GameServer::prerender(const SessionPtr& session) {
+    scheduler_->submitIdle([this, session] {
+        // The turn that queued this has let go of the content, so a
+        // definition replaced by a reload meanwhile may be freed now
+        if (options_.content) {
+            options_.content->collect();
+        }
+
+        // Claim the session only now, so lines that arrived while this waited are not held back
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            if (session->scheduled || session->quit || session->peerClosed ||
+                !session->pending.empty()) {
+                return;
+            }
+            session->scheduled = true;
+        }
+
+        try {
+            session->engine.prerender();
+        } catch (const std::exception& e) {
+            std::cerr << "Error prerendering session: " << e.what() << std::endl;
+        }
+
+        bool more;
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            more = !session->pending.empty() && !session->quit;
+            session->scheduled = more;
+        }
+        if (more) {
+            scheduler_->submit([this, session] { runSession(session); });
+        }
+    });
+}
+
+SessionTask GameServer::playSession(Session& session) {
+    emit(session, session.engine.start().output, true);
+
+    while (true) {
+        std::string line = co_await session.lines.next();
+        GameEngine::TurnResult result = session.engine.step(line);
+        emit(session, result.output, !result.quit);
+        if (result.quit) {
+            co_return;
+        }
+    }
+}
+
+void GameServer::emit(Session& session, std::string_view text, bool prompt) {
+    std::lock_guard<std::mutex> lock(session.mutex);
+    session.output += text;
+    if (prompt) {
+        session.output += kPrompt;
+    } else {
+        session.quit = true;
+    }
+}
+
+void GameServer::notifyReady(const SessionPtr& session) {
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(readyMutex_);
+        wasEmpty = ready_.empty();
+        ready_.push_back(session);
+    }
+    if (wasEmpty) {
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeFd_, &one, sizeof(one));
+        (void)ignored;
+    }
+}
+
+void GameServer::drainReady() {
+    std::vector<SessionPtr> ready;
+    {
+        std::lock_guard<std::mutex> lock(readyMutex_);
+        ready.swap(ready_);
+    }
+
+    for (const auto& session : ready) {
+        if (session->fd < 0) continue;  // closed while its turn was running
+        flushOutput(*session);
+        finishEvent(session);
+    }
+}
+
+void GameServer::flushOutput(Session& session) {
+    std::lock_guard<std::mutex> lock(session.mutex);
+
+    while (session.outputOffset < session.output.size()) {
+        ssize_t sent = send(session.fd,
+                            session.output.data() + session.outputOffset,
+                            session.output.size() - session.outputOffset,
+                            MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                // Connection is gone: drop the output and close
+                session.quit = true;
+                session.output.clear();
+                session.outputOffset = 0;
+            }
+            return;
+        }
+        session.outputOffset += static_cast<size_t>(sent);
+    }
+
+    session.output.clear();
+    session.outputOffset = 0;
+}
+
+void GameServer::finishEvent(const SessionPtr& session) {
+    if (session->fd < 0) return;
+
+    bool done;
+    uint32_t events = 0;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        bool flushed = session->outputOffset == session->output.size();
+        bool answered = session->pending.empty() && !session->scheduled;
+        done = flushed && (session->quit || (session->peerClosed && answered));
+
+        if (!session->quit && !session->peerClosed) events |= EPOLLIN;
+        if (!flushed) events |= EPOLLOUT;
+    }
+
+    if (done) {
+        closeSession(*session);
+        return;
+    }
+
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = session->fd;
+    epoll_ctl(epollFd_, EPOLL_CTL_MOD, session->fd, &event);
+}
+
+void GameServer::closeSession(Session& session) {
+    int fd = session.fd;
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    session.fd = -1;
+    sessions_.erase(fd);
+}
@@ -1,19 +1,16 @@
 #include "game_world.h"
 #include "environment_builder.h"
 
-GameWorld::GameWorld()
-    : currentEnvironment_(nullptr), currentLocation_(nullptr) {
+GameWorld::GameWorld(uint64_t seed)
+    : seed_(seed), builtCount_(0), currentEnvironment_(nullptr), currentLocation_(nullptr) {
     initialize();
 }
 
 void GameWorld::initialize() {
     createEnvironments();
-    
-    // Set starting location (Village of Luminara)
-    if (!environments_.empty()) {
-        currentEnvironment_ = environments_[0].get();
-        currentLocation_ = currentEnvironment_->getLocation(1, 1);  // Center of grid
-    }
+
+    // Set starting location (Village of Luminara), the only environment built up front
+    setCurrentLocation(0, 1, 1);  // Center of grid
 }
 
 bool GameWorld::move(Location::Direction direction) {
@@ -22,75 +19,192 @@ bool GameWorld::move(Location::Direction direction) {
     Location* nextLocation = currentLocation_->getExit(direction);
     if (!nextLocation) return false;
 
-    // Check if we're moving to a different environment
-    [[maybe_unused]] auto currentCoords = getLocationCoordinates(currentLocation_);
-    auto nextCoords = getLocationCoordinates(nextLocation);
-
-    if (!nextCoords.has_value()) {
-        // Moving to a different environment
-        for (const auto& env : environments_) {
-            auto coords = getLocationCoordinates(nextLocation);
-            if (coords.has_value()) {
-                currentEnvironment_ = env.get();
-                break;
-            }
-        }
+    // Exits between environments lead into another grid
+    LocationStore::Placement placement = locations_.getPlacement(nextLocation->getId());
+    if (placement.environment) {
+        currentEnvironment_ = placement.environment;
     }
 
     currentLocation_ = nextLocation;
+    if (ProceduralRegion* region = findRegion(currentEnvironment_)) {
+        region->approach(placement.x, placement.y);
+    }
+    buildConnectionsAt(indexOf(currentEnvironment_), placement.x, placement.y);
     return true;
 }
 
 std::optional<std::pair<int, int>> GameWorld::getLocationCoordinates(
     const Location* location) const {
-    
-    for (int y = 0; y < LocationGrid::GRID_SIZE; ++y) {
-        for (int x = 0; x < LocationGrid::GRID_SIZE; ++x) {
-            if (currentEnvironment_->getLocation(x, y) == location) {
-                return std::make_pair(x, y);
-            }
+
+    if (!location || locations_.get(location->getId()) != location) {
+        return std::nullopt;
+    }
+    const auto& placement = locations_.getPlacement(location->getId());
+    if (!placement.environment) {
+        return std::nullopt;
+    }
+    return std::make_pair(placement.x, placement.y);
+}
+
+LocationGrid* GameWorld::getEnvironment(size_t index) {
+    if (index >= types_.size()) {
+        return nullptr;
+    }
+    if (!environments_[index]) {
+        buildEnvironment(index);
+    }
+    return environments_[index].get();
+}
+
+LocationGrid* GameWorld::findEnvironment(size_t index) const {
+    return index < environments_.size() ? environments_[index].get() : nullptr;
+}
+
+Location* GameWorld::getLocation(size_t index, int x, int y) {
+    LocationGrid* environment = getEnvironment(index);
+    if (ProceduralRegion* region = findRegion(environment)) {
+        return region->materialize(x, y);
+    }
+    return environment ? environment->getLocation(x, y) : nullptr;
+}
+
+bool GameWorld::setCurrentLocation(size_t index, int x, int y) {
+    Location* location = getLocation(index, x, y);
+    if (!location) {
+        return false;
+    }
+
+    currentEnvironment_ = getEnvironment(index);
+    currentLocation_ = location;
+    if (ProceduralRegion* region = findRegion(currentEnvironment_)) {
+        region->approach(x, y);
+    }
+    buildConnectionsAt(index, x, y);
+    return true;
+}
+
+bool GameWorld::prefetch() {
+    size_t current = indexOf(currentEnvironment_);
+    size_t built = builtCount_;
+    for (const auto& connection : connections_) {
+        if (connection.from == current) {
+            getEnvironment(connection.to);
+        } else if (connection.to == current) {
+            getEnvironment(connection.from);
         }
     }
-    return std::nullopt;
+    return builtCount_ != built;
 }
 
 void GameWorld::createEnvironments() {
-    // Create each environment from the game design
-    environments_.push_back(createEnvironment(EnvironmentType::VILLAGE_OF_LUMINARA));
-    environments_.push_back(createEnvironment(EnvironmentType::WHISPERING_WOODS));
-    environments_.push_back(createEnvironment(EnvironmentType::CRYSTAL_CAVES));
-    environments_.push_back(createEnvironment(EnvironmentType::FORGOTTEN_LIBRARY));
-    environments_.push_back(createEnvironment(EnvironmentType::ECHOING_MOUNTAINS));
-    environments_.push_back(createEnvironment(EnvironmentType::SHADOW_MARSHES));
-    environments_.push_back(createEnvironment(EnvironmentType::SANCTUM_OF_LIGHT));
-    environments_.push_back(createEnvironment(EnvironmentType::MALAKARS_LAIR));
-    
-    // Hidden Grove is initially locked
-    auto hiddenGrove = createEnvironment(EnvironmentType::HIDDEN_GROVE);
-    environments_.push_back(std::move(hiddenGrove));
+    // Each environment from the game design, built when first needed
+    types_ = {
+        EnvironmentType::VILLAGE_OF_LUMINARA,
+        EnvironmentType::WHISPERING_WOODS,
+        EnvironmentType::CRYSTAL_CAVES,
+        EnvironmentType::FORGOTTEN_LIBRARY,
+        EnvironmentType::ECHOING_MOUNTAINS,
+        EnvironmentType::SHADOW_MARSHES,
+        EnvironmentType::SANCTUM_OF_LIGHT,
+        EnvironmentType::MALAKARS_LAIR,
+        // Hidden Grove is initially locked
+        EnvironmentType::HIDDEN_GROVE,
+        // Generated wilderness around the handcrafted areas
+        EnvironmentType::MARSH_WILDS,
+        EnvironmentType::MOUNTAIN_WILDS,
+    };
+    environments_.resize(types_.size());
 
     // Connect environments according to the game design
     connectEnvironments(
-        environments_[0].get(),  // Village of Luminara
-        environments_[0]->getLocation(1, 0),  // North exit
-        environments_[1].get(),  // Whispering Woods
-        environments_[1]->getLocation(1, 2)   // South entrance
+        0, 1, 0,  // Village of Luminara, north exit
+        1, 1, 2   // Whispering Woods, south entrance
+    );
+
+    // The marsh wilds stretch south of the Shadow Marshes and the mountain
+    // wilds north of the Echoing Mountains, entered at the middle of an edge
+    const int middle = LocationGrid::MAX_SIZE / 2;
+    connectEnvironments(
+        9, middle, 0,  // Marsh Wilds, north edge
+        5, 1, 2        // Shadow Marshes, south exit
+    );
+    connectEnvironments(
+        4, 1, 0,                               // Echoing Mountains, north exit
+        10, middle, LocationGrid::MAX_SIZE - 1  // Mountain Wilds, south edge
     );
 
     // Add other environment connections as per the game design...
 }
 
 std::unique_ptr<LocationGrid> GameWorld::createEnvironment(EnvironmentType type) {
-    return EnvironmentBuilder::buildEnvironment(type);
+    auto environment = EnvironmentBuilder::buildEnvironment(type, locations_);
+    if (environment && isProcedural(type)) {
+        regions_.push_back(std::make_unique<ProceduralRegion>(type, seed_, *environment, locations_));
+    }
+    return environment;
+}
+
+void GameWorld::buildEnvironment(size_t index) {
+    environments_[index] = createEnvironment(types_[index]);
+    ++builtCount_;
+
+    // Link the connections whose other side already exists
+    for (const auto& connection : connections_) {
+        if ((connection.from == index && environments_[connection.to]) ||
+            (connection.to == index && environments_[connection.from])) {
+            linkConnection(connection);
+        }
+    }
 }
 
-void GameWorld::connectEnvironments(
-    LocationGrid* env1, Location* exit1,
-    LocationGrid* env2, Location* exit2) {
-    
-    if (env1 && exit1 && env2 && exit2) {
+void GameWorld::buildConnectionsAt(size_t index, int x, int y) {
+    for (const auto& connection : connections_) {
+        if (connection.from == index && connection.fromX == x && connection.fromY == y) {
+            getEnvironment(connection.to);
+        } else if (connection.to == index && connection.toX == x && connection.toY == y) {
+            getEnvironment(connection.from);
+        }
+    }
+}
+
+size_t GameWorld::indexOf(const LocationGrid* environment) const {
+    for (size_t index = 0; index < environments_.size(); ++index) {
+        if (environments_[index].get() == environment) {
+            return index;
+        }
+    }
+    return environments_.size();
+}
+
+ProceduralRegion* GameWorld::findRegion(const LocationGrid* environment) const {
+    for (const auto& region : regions_) {
+        if (&region->getGrid() == environment) {
+            return region.get();
+        }
+    }
+    return nullptr;
+}
+
+Location* GameWorld::findEndpoint(size_t index, int x, int y) const {
+    LocationGrid* environment = environments_[index].get();
+    // Entry cells of procedural regions are pinned so the exit survives eviction
+    if (ProceduralRegion* region = findRegion(environment)) {
+        return region->anchor(x, y);
+    }
+    return environment->getLocation(x, y);
+}
+
+void GameWorld::connectEnvironments(size_t env1, int x1, int y1, size_t env2, int x2, int y2) {
+    connections_.push_back(Connection{env1, x1, y1, env2, x2, y2});
+}
+
+void GameWorld::linkConnection(const Connection& connection) {
+    Location* exit1 = findEndpoint(connection.from, connection.fromX, connection.fromY);
+    Location* exit2 = findEndpoint(connection.to, connection.toX, connection.toY);
+
+    if (exit1 && exit2) {
         // Create one-way connections between environments
         exit1->addExit(Location::Direction::NORTH, exit2);
         exit2->addExit(Location::Direction::SOUTH, exit1);
     }
-}
\ No newline at end of file
+}
@@ -1,12 +1,19 @@
 #include "item.h"
 
 Item::Item(const std::string& id, const std::string& name, const std::string& description)
-    : Entity(name, description), item_id_(id), current_location_(nullptr) {}
+    : Entity(name, description),
+      item_id_(id),
+      item_symbol_(SymbolTable::global().intern(id)),
+      current_location_(nullptr) {}
 
 std::string Item::GetItemId() const {
     return item_id_;
 }
 
+Symbol Item::GetItemSymbol() const {
+    return item_symbol_;
+}
+
 bool Item::PickUp() {
     if (current_location_ == nullptr) {
         return false;
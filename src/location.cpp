@@ -1,26 +1,31 @@
 #include "location.h"
+#include "location_store.h"
 #include "item.h"
 #include "npc.h"
 #include "puzzle.h"
 #include <algorithm>
-#include <sstream>
+#include <iterator>
 
 Location::Location(const std::string& name, const std::string& description)
-    : name_(name), description_(description) {}
+    : store_(nullptr), id_(kNoLocation), name_(name), description_(description) {}
+
+Location::Location(LocationStore& store, LocationId id, const std::string& name, const std::string& description)
+    : store_(&store), id_(id), name_(name), description_(description) {}
 
 bool Location::addExit(Direction direction, Location* location) {
-    // Don't allow null locations or overwriting existing exits
-    if (location == nullptr || exits_.find(direction) != exits_.end()) {
+    // Exits only connect rooms of the same store
+    if (location == nullptr || store_ == nullptr || location->store_ != store_) {
         return false;
     }
-    
-    exits_[direction] = location;
-    return true;
+    return store_->link(id_, direction, location->id_);
 }
 
 Location* Location::getExit(Direction direction) const {
-    auto it = exits_.find(direction);
-    return (it != exits_.end()) ? it->second : nullptr;
+    return store_ ? store_->get(store_->getExit(id_, direction)) : nullptr;
+}
+
+bool Location::hasExit(Direction direction) const {
+    return store_ && store_->getExit(id_, direction) != kNoLocation;
 }
 
 void Location::addItem(std::shared_ptr<Item> item) {
@@ -30,10 +35,14 @@ void Location::addItem(std::shared_ptr<Item> item) {
     }
 }
 
-std::shared_ptr<Item> Location::removeItem(const std::string& itemName) {
+std::shared_ptr<Item> Location::removeItem(std::string_view itemName) {
+    return removeItem(SymbolTable::global().find(itemName));
+}
+
+std::shared_ptr<Item> Location::removeItem(Symbol name) {
     auto it = std::find_if(items_.begin(), items_.end(),
-                          [&itemName](const std::shared_ptr<Item>& item) {
-                              return item->getName() == itemName;
+                          [name](const std::shared_ptr<Item>& item) {
+                              return item->isNamed(name);
                           });
     
     if (it != items_.end()) {
@@ -45,6 +54,22 @@ std::shared_ptr<Item> Location::removeItem(const std::string& itemName) {
     return nullptr;
 }
 
+std::shared_ptr<Item> Location::getItem(Symbol name) const {
+    auto it = std::find_if(items_.begin(), items_.end(),
+                          [name](const std::shared_ptr<Item>& item) {
+                              return item->isNamed(name);
+                          });
+    return (it != items_.end()) ? *it : nullptr;
+}
+
+std::shared_ptr<NPC> Location::getNPC(Symbol name) const {
+    auto it = std::find_if(npcs_.begin(), npcs_.end(),
+                          [name](const std::shared_ptr<NPC>& npc) {
+                              return npc->isNamed(name);
+                          });
+    return (it != npcs_.end()) ? *it : nullptr;
+}
+
 void Location::addNPC(std::shared_ptr<NPC> npc) {
     if (npc) {
         npcs_.push_back(npc);
@@ -55,50 +80,47 @@ void Location::setPuzzle(std::shared_ptr<Puzzle> puzzle) {
     puzzle_ = puzzle;
 }
 
-std::string Location::getFullDescription() const {
-    std::stringstream desc;
-    
+std::pmr::string Location::getFullDescription(std::pmr::memory_resource* memory) const {
+    std::pmr::string desc(memory);
+
     // Basic description
-    desc << description_ << "\n";
+    desc.append(description_).append("\n");
 
     // List items
     if (!items_.empty()) {
-        desc << "\nYou can see:";
+        desc.append("\nYou can see:");
         for (const auto& item : items_) {
-            desc << "\n- " << item->getName();
+            desc.append("\n- ").append(item->getName());
         }
     }
 
     // List NPCs
     if (!npcs_.empty()) {
-        desc << "\n\nPresent here:";
+        desc.append("\n\nPresent here:");
         for (const auto& npc : npcs_) {
-            desc << "\n- " << npc->getName();
+            desc.append("\n- ").append(npc->getName());
         }
     }
 
-    // List exits
-    if (!exits_.empty()) {
-        desc << "\n\nExits:";
-        for (const auto& [direction, location] : exits_) {
-            switch (direction) {
-                case Direction::NORTH:
-                    desc << "\n- North"; break;
-                case Direction::SOUTH:
-                    desc << "\n- South"; break;
-                case Direction::EAST:
-                    desc << "\n- East"; break;
-                case Direction::WEST:
-                    desc << "\n- West"; break;
-            }
-            desc << " (to " << location->getName() << ")";
+    // List exits, always in slot order
+    static constexpr const char* kExitNames[] = {"North", "East", "South", "West"};
+    bool listedExits = false;
+    for (size_t slot = 0; store_ && slot < std::size(kExitNames); ++slot) {
+        const Location* location = store_->get(store_->getExits(id_)[slot]);
+        if (!location) continue;
+
+        if (!listedExits) {
+            desc.append("\n\nExits:");
+            listedExits = true;
         }
+        desc.append("\n- ").append(kExitNames[slot]);
+        desc.append(" (to ").append(location->getName()).append(")");
     }
 
     // Mention puzzle if present
     if (puzzle_) {
-        desc << "\n\nThere appears to be a puzzle here: " << puzzle_->GetName();
+        desc.append("\n\nThere appears to be a puzzle here: ").append(puzzle_->GetName());
     }
 
-    return desc.str();
+    return desc;
 }
\ No newline at end of file
@@ -1,18 +1,37 @@
 #include "location_grid.h"
+#include <algorithm>
+#include <stdexcept>
 
-LocationGrid::LocationGrid(const std::string& name) : name_(name) {
-    // Initialize grid with nullptr
-    for (auto& row : grid_) {
-        row.fill(nullptr);
+LocationGrid::LocationGrid(const std::string& name, int width, int height)
+    : name_(name), width_(width), height_(height) {
+    if (width < 1 || width > MAX_SIZE || height < 1 || height > MAX_SIZE) {
+        throw std::invalid_argument("Grid size out of range: " + std::to_string(width) + "x" +
+                                    std::to_string(height));
     }
 }
 
-bool LocationGrid::setLocation(int x, int y, std::shared_ptr<Location> location) {
+bool LocationGrid::setLocation(int x, int y, Location* location) {
     if (!isValidCoordinate(x, y)) {
         return false;
     }
 
-    grid_[y][x] = std::move(location);
+    int chunkX = x / CHUNK_SIZE;
+    int chunkY = y / CHUNK_SIZE;
+    Chunk* chunk = findChunk(chunkX, chunkY);
+    if (!chunk) {
+        // Clearing a cell never allocates
+        if (!location) {
+            return true;
+        }
+        chunks_.push_back(std::make_unique<Chunk>());
+        chunk = chunks_.back().get();
+        chunk->originX = chunkX * CHUNK_SIZE;
+        chunk->originY = chunkY * CHUNK_SIZE;
+        chunk->cells.fill(nullptr);
+        directory_.emplace(interleave(chunkX, chunkY), chunk);
+    }
+
+    chunk->cells[interleave(x % CHUNK_SIZE, y % CHUNK_SIZE)] = location;
     return true;
 }
 
@@ -21,29 +40,119 @@ Location* LocationGrid::getLocation(int x, int y) const {
         return nullptr;
     }
 
-    return grid_[y][x].get();
+    const Chunk* chunk = findChunk(x / CHUNK_SIZE, y / CHUNK_SIZE);
+    return chunk ? chunk->cells[interleave(x % CHUNK_SIZE, y % CHUNK_SIZE)] : nullptr;
 }
 
 void LocationGrid::connectGridLocations() {
-    for (int y = 0; y < GRID_SIZE; ++y) {
-        for (int x = 0; x < GRID_SIZE; ++x) {
-            if (!grid_[y][x]) continue;
-
-            // Connect to north
-            if (y > 0 && grid_[y-1][x]) {
-                grid_[y][x]->addExit(Location::Direction::NORTH, grid_[y-1][x].get());
-                grid_[y-1][x]->addExit(Location::Direction::SOUTH, grid_[y][x].get());
-            }
+    for (const auto& chunk : chunks_) {
+        int chunkX = chunk->originX / CHUNK_SIZE;
+        int chunkY = chunk->originY / CHUNK_SIZE;
+        const Chunk* east = findChunk(chunkX + 1, chunkY);
+        const Chunk* south = findChunk(chunkX, chunkY + 1);
 
-            // Connect to east
-            if (x < GRID_SIZE-1 && grid_[y][x+1]) {
-                grid_[y][x]->addExit(Location::Direction::EAST, grid_[y][x+1].get());
-                grid_[y][x+1]->addExit(Location::Direction::WEST, grid_[y][x].get());
+        for (uint32_t x = 0; x < CHUNK_SIZE; ++x) {
+            for (uint32_t y = 0; y < CHUNK_SIZE; ++y) {
+                Location* location = chunk->cells[interleave(x, y)];
+                if (!location) continue;
+
+                // Connect to east, crossing into the next chunk at the edge
+                link(location, Location::Direction::EAST,
+                     x + 1 < CHUNK_SIZE ? chunk->cells[interleave(x + 1, y)]
+                     : east              ? east->cells[interleave(0, y)]
+                                         : nullptr);
+
+                // Connect to south; north is y - 1
+                link(location, Location::Direction::SOUTH,
+                     y + 1 < CHUNK_SIZE ? chunk->cells[interleave(x, y + 1)]
+                     : south             ? south->cells[interleave(x, 0)]
+                                         : nullptr);
             }
         }
     }
 }
 
+void LocationGrid::connectChunk(int chunkX, int chunkY) {
+    const Chunk* chunk = findChunk(chunkX, chunkY);
+    if (!chunk) {
+        return;
+    }
+    const Chunk* north = findChunk(chunkX, chunkY - 1);
+    const Chunk* east = findChunk(chunkX + 1, chunkY);
+    const Chunk* south = findChunk(chunkX, chunkY + 1);
+    const Chunk* west = findChunk(chunkX - 1, chunkY);
+
+    for (uint32_t i = 0; i < CHUNK_SIZE; ++i) {
+        for (uint32_t j = 0; j + 1 < CHUNK_SIZE; ++j) {
+            link(chunk->cells[interleave(j, i)], Location::Direction::EAST, chunk->cells[interleave(j + 1, i)]);
+            link(chunk->cells[interleave(i, j)], Location::Direction::SOUTH, chunk->cells[interleave(i, j + 1)]);
+        }
+
+        // Edges shared with the chunks around
+        const uint32_t last = CHUNK_SIZE - 1;
+        if (north) link(chunk->cells[interleave(i, 0)], Location::Direction::NORTH, north->cells[interleave(i, last)]);
+        if (east) link(chunk->cells[interleave(last, i)], Location::Direction::EAST, east->cells[interleave(0, i)]);
+        if (south) link(chunk->cells[interleave(i, last)], Location::Direction::SOUTH, south->cells[interleave(i, 0)]);
+        if (west) link(chunk->cells[interleave(0, i)], Location::Direction::WEST, west->cells[interleave(last, i)]);
+    }
+}
+
+bool LocationGrid::releaseChunk(int chunkX, int chunkY) {
+    if (chunkX < 0 || chunkY < 0) {
+        return false;
+    }
+    auto it = directory_.find(interleave(chunkX, chunkY));
+    if (it == directory_.end()) {
+        return false;
+    }
+
+    // Swap the last chunk into the freed slot; order only needs to be repeatable
+    auto owner = std::find_if(chunks_.begin(), chunks_.end(),
+                              [chunk = it->second](const auto& candidate) { return candidate.get() == chunk; });
+    std::swap(*owner, chunks_.back());
+    chunks_.pop_back();
+    directory_.erase(it);
+    return true;
+}
+
+void LocationGrid::link(Location* from, Location::Direction direction, Location* to) {
+    if (!from || !to) {
+        return;
+    }
+    static constexpr Location::Direction kOpposite[] = {
+        Location::Direction::SOUTH, Location::Direction::WEST,
+        Location::Direction::NORTH, Location::Direction::EAST,
+    };
+    from->addExit(direction, to);
+    to->addExit(kOpposite[static_cast<size_t>(direction)], from);
+}
+
 bool LocationGrid::isValidCoordinate(int x, int y) const {
-    return x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE;
+    return x >= 0 && x < width_ && y >= 0 && y < height_;
+}
+
+LocationGrid::Chunk* LocationGrid::findChunk(int chunkX, int chunkY) const {
+    if (chunkX < 0 || chunkY < 0) {
+        return nullptr;
+    }
+    auto it = directory_.find(interleave(chunkX, chunkY));
+    return it != directory_.end() ? it->second : nullptr;
+}
+
+uint32_t LocationGrid::spread(uint32_t value) {
+    value &= 0x0000ffff;
+    value = (value | (value << 8)) & 0x00ff00ff;
+    value = (value | (value << 4)) & 0x0f0f0f0f;
+    value = (value | (value << 2)) & 0x33333333;
+    value = (value | (value << 1)) & 0x55555555;
+    return value;
+}
+
+uint32_t LocationGrid::compact(uint32_t value) {
+    value &= 0x55555555;
+    value = (value | (value >> 1)) & 0x33333333;
+    value = (value | (value >> 2)) & 0x0f0f0f0f;
+    value = (value | (value >> 4)) & 0x00ff00ff;
+    value = (value | (value >> 8)) & 0x0000ffff;
+    return value;
 }
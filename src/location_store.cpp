@@ -0,0 +1,53 @@
+#include "location_store.h"
+
+Location* LocationStore::create(const std::string& name, const std::string& description) {
+    LocationId id;
+    if (!freeIds_.empty()) {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    } else {
+        id = static_cast<LocationId>(rooms_.size());
+        rooms_.emplace_back();
+        exits_.emplace_back();
+        placements_.emplace_back();
+    }
+
+    rooms_[id].reset(new Location(*this, id, name, description));
+    exits_[id].fill(kNoLocation);
+    placements_[id] = Placement{};
+    ++layoutVersion_;
+    return rooms_[id].get();
+}
+
+bool LocationStore::destroy(LocationId id) {
+    if (!get(id)) {
+        return false;
+    }
+
+    for (LocationId neighbour : exits_[id]) {
+        if (neighbour == kNoLocation) continue;
+        for (LocationId& back : exits_[neighbour]) {
+            if (back == id) back = kNoLocation;
+        }
+    }
+
+    rooms_[id].reset();
+    freeIds_.push_back(id);
+    ++layoutVersion_;
+    return true;
+}
+
+bool LocationStore::link(LocationId from, Location::Direction direction, LocationId to) {
+    // Don't allow unknown locations or overwriting existing exits
+    if (!get(from) || !get(to)) {
+        return false;
+    }
+
+    LocationId& slot = exits_[from][static_cast<size_t>(direction)];
+    if (slot != kNoLocation) {
+        return false;
+    }
+    slot = to;
+    ++layoutVersion_;
+    return true;
+}
@@ -1,13 +1,95 @@
+#include "content_store.h"
 #include "game_engine.h"
+#include "game_server.h"
+#include <csignal>
+#include <cstring>
 #include <iostream>
+#include <string>
 
-int main() {
+namespace {
+
+GameServer* activeServer = nullptr;
+
+void handleStopSignal(int) {
+    if (activeServer) {
+        activeServer->stop();
+    }
+}
+
+void handleReloadSignal(int) {
+    if (activeServer) {
+        activeServer->requestReload();
+    }
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--unix PATH] [--tcp PORT] [--threads N] [--journal DIR] [--content FILE]\n"
+              << "  Without options the game is played on the console.\n"
+              << "  --unix PATH    Host sessions on a Unix-domain socket\n"
+              << "  --tcp PORT     Host sessions on a localhost TCP port\n"
+              << "  --threads N    Worker threads running turns (default: one per core)\n"
+              << "  --journal DIR  Journal the console game to DIR and resume it on restart;\n"
+              << "                 not with --unix or --tcp\n"
+              << "  --content FILE Override location and item text; servers reload it on SIGHUP\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
     try {
-        GameEngine engine;
-        engine.run();
+        GameServer::Options options;
+        std::string journalDirectory;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--unix") == 0 && i + 1 < argc) {
+                options.unixPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--tcp") == 0 && i + 1 < argc) {
+                options.tcpPort = std::stoi(argv[++i]);
+            } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                options.workerThreads = static_cast<size_t>(std::stoul(argv[++i]));
+            } else if (std::strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+                journalDirectory = argv[++i];
+            } else if (std::strcmp(argv[i], "--content") == 0 && i + 1 < argc) {
+                options.contentPath = argv[++i];
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+
+        // Server sessions are not journaled; say so instead of ignoring it
+        bool serving = !options.unixPath.empty() || options.tcpPort != 0;
+        if (serving && !journalDirectory.empty()) {
+            std::cerr << "--journal only applies to the console game\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        ContentStore content;
+        if (!options.contentPath.empty()) {
+            content.publish(WorldContent::load(options.contentPath));
+        }
+        options.content = &content;
+
+        if (!serving) {
+            GameEngine engine;
+            engine.setContentStore(&content);
+            if (!journalDirectory.empty()) {
+                engine.openJournal(journalDirectory);
+            }
+            engine.run();
+            return 0;
+        }
+
+        GameServer server(options);
+        activeServer = &server;
+        std::signal(SIGINT, handleStopSignal);
+        std::signal(SIGTERM, handleStopSignal);
+        std::signal(SIGHUP, handleReloadSignal);
+        server.run();
+        activeServer = nullptr;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
     }
     return 0;
-}
\ No newline at end of file
+}
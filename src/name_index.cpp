@@ -0,0 +1,232 @@
+#include "name_index.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+char lowerChar(char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+bool equalsIgnoringCase(std::string_view lower, std::string_view text) {
+    return lower.size() == text.size() &&
+           std::equal(lower.begin(), lower.end(), text.begin(),
+                      [](char a, char b) { return a == lowerChar(b); });
+}
+
+}  // namespace
+
+NameIndex::NameIndex() : nodes_(1), size_(0) {}
+
+void NameIndex::insert(std::string_view name) {
+    uint32_t id = findName(name);
+    if (id != kNone) {
+        ++names_[id].references;
+        return;
+    }
+
+    if (free_.empty()) {
+        free_.push_back(static_cast<uint32_t>(names_.size()));
+        names_.emplace_back();
+    }
+    id = free_.back();
+    free_.pop_back();
+
+    // Reassigning keeps the capacity of a recycled entry's strings
+    Name& entry = names_[id];
+    entry.display.assign(name);
+    entry.lower.assign(name);
+    std::transform(entry.lower.begin(), entry.lower.end(), entry.lower.begin(), lowerChar);
+    entry.references = 1;
+    ++size_;
+
+    forEachKey(entry.lower, [this, id](std::string_view key) {
+        uint32_t node = walk(key);
+        nodes_[node].names.push_back(id);
+    });
+}
+
+void NameIndex::erase(std::string_view name) {
+    uint32_t id = findName(name);
+    if (id == kNone || --names_[id].references > 0) {
+        return;
+    }
+
+    // Emptied nodes stay behind; names come back often enough to reuse them
+    forEachKey(names_[id].lower, [this, id](std::string_view key) {
+        auto& ids = nodes_[find(key)].names;
+        ids.erase(std::find(ids.begin(), ids.end(), id));
+    });
+    names_[id].display.clear();
+    names_[id].lower.clear();
+    free_.push_back(id);
+    --size_;
+}
+
+void NameIndex::clear() {
+    nodes_.assign(1, Node{});
+    names_.clear();
+    free_.clear();
+    size_ = 0;
+}
+
+std::string_view NameIndex::resolve(std::string_view text, std::pmr::memory_resource* memory) const {
+    uint32_t node = find(text);
+    if (node == kNone) {
+        return {};
+    }
+
+    for (uint32_t id : nodes_[node].names) {
+        if (equalsIgnoringCase(names_[id].lower, text)) {
+            return names_[id].display;
+        }
+    }
+
+    std::pmr::vector<uint32_t> found(memory);
+    collect(node, found);
+    return found.size() == 1 ? std::string_view(names_[found[0]].display) : std::string_view();
+}
+
+std::string_view NameIndex::suggest(std::string_view text, size_t maxDistance,
+                                    std::pmr::memory_resource* memory) const {
+    // Classic Levenshtein rows, computed once per trie edge instead of per
+    // name. Keys longer than text + maxDistance cannot be close enough, so
+    // one buffer holds the rows of every depth the search can reach
+    size_t width = text.size() + 1;
+    std::pmr::vector<size_t> rows(width * (width + maxDistance + 1), memory);
+    for (size_t i = 0; i < width; ++i) {
+        rows[i] = i;
+    }
+
+    std::pair<uint32_t, size_t> best{kNone, maxDistance + 1};
+    for (const auto& [c, child] : nodes_[0].children) {
+        suggestFrom(child, c, text, rows, 1, maxDistance, best);
+    }
+    return best.first == kNone ? std::string_view() : std::string_view(names_[best.first].display);
+}
+
+void NameIndex::complete(std::string_view text, std::vector<std::string_view>& out) const {
+    uint32_t node = find(text);
+    if (node == kNone) {
+        return;
+    }
+
+    size_t first = out.size();
+    completeFrom(node, out, first);
+
+    auto startsWithText = [text](std::string_view name) {
+        return name.size() >= text.size() &&
+               std::equal(text.begin(), text.end(), name.begin(),
+                          [](char x, char y) { return lowerChar(x) == lowerChar(y); });
+    };
+    std::sort(out.begin() + first, out.end(), [&](std::string_view a, std::string_view b) {
+        bool aFirst = startsWithText(a);
+        bool bFirst = startsWithText(b);
+        if (aFirst != bFirst) {
+            return aFirst;
+        }
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+                                            [](char x, char y) { return lowerChar(x) < lowerChar(y); });
+    });
+}
+
+uint32_t NameIndex::findName(std::string_view name) const {
+    uint32_t node = find(name);
+    if (node == kNone) {
+        return kNone;
+    }
+    for (uint32_t id : nodes_[node].names) {
+        if (equalsIgnoringCase(names_[id].lower, name)) {
+            return id;
+        }
+    }
+    return kNone;
+}
+
+uint32_t NameIndex::walk(std::string_view key) {
+    uint32_t node = 0;
+    for (char c : key) {
+        auto& children = nodes_[node].children;
+        auto it = std::lower_bound(children.begin(), children.end(), c,
+            [](const std::pair<char, uint32_t>& child, char value) { return child.first < value; });
+        if (it != children.end() && it->first == c) {
+            node = it->second;
+            continue;
+        }
+
+        uint32_t next = static_cast<uint32_t>(nodes_.size());
+        children.insert(it, {c, next});
+        nodes_.emplace_back();
+        node = next;
+    }
+    return node;
+}
+
+uint32_t NameIndex::find(std::string_view key) const {
+    uint32_t node = 0;
+    for (char c : key) {
+        c = lowerChar(c);
+        const auto& children = nodes_[node].children;
+        auto it = std::lower_bound(children.begin(), children.end(), c,
+            [](const std::pair<char, uint32_t>& child, char value) { return child.first < value; });
+        if (it == children.end() || it->first != c) {
+            return kNone;
+        }
+        node = it->second;
+    }
+    return node;
+}
+
+void NameIndex::collect(uint32_t node, std::pmr::vector<uint32_t>& found) const {
+    for (uint32_t id : nodes_[node].names) {
+        if (std::find(found.begin(), found.end(), id) == found.end()) {
+            found.push_back(id);
+            if (found.size() > 1) return;
+        }
+    }
+    for (const auto& child : nodes_[node].children) {
+        collect(child.second, found);
+        if (found.size() > 1) return;
+    }
+}
+
+void NameIndex::completeFrom(uint32_t node, std::vector<std::string_view>& out, size_t first) const {
+    // A name shows up under every matching word, but is listed once
+    for (uint32_t id : nodes_[node].names) {
+        std::string_view name = names_[id].display;
+        if (std::none_of(out.begin() + first, out.end(),
+                         [name](std::string_view listed) { return listed.data() == name.data(); })) {
+            out.push_back(name);
+        }
+    }
+    for (const auto& child : nodes_[node].children) {
+        completeFrom(child.second, out, first);
+    }
+}
+
+void NameIndex::suggestFrom(uint32_t node, char c, std::string_view text, std::pmr::vector<size_t>& rows,
+                            size_t depth, size_t maxDistance, std::pair<uint32_t, size_t>& best) const {
+    size_t width = text.size() + 1;
+    const size_t* previous = &rows[(depth - 1) * width];
+    size_t* row = &rows[depth * width];
+
+    row[0] = previous[0] + 1;
+    size_t smallest = row[0];
+    for (size_t i = 1; i < width; ++i) {
+        size_t substitution = previous[i - 1] + (text[i - 1] == c ? 0 : 1);
+        row[i] = std::min({row[i - 1] + 1, previous[i] + 1, substitution});
+        smallest = std::min(smallest, row[i]);
+    }
+
+    size_t distance = row[width - 1];
+    if (distance < best.second && !nodes_[node].names.empty()) {
+        best = {nodes_[node].names.front(), distance};
+    }
+
+    // Deeper nodes can only move further away once every cell exceeds the bound
+    if (smallest <= maxDistance && smallest < best.second) {
+        for (const auto& [next, child] : nodes_[node].children) {
+            suggestFrom(child, next, text, rows, depth + 1, maxDistance, best);
+        }
+    }
+}
@@ -7,6 +7,7 @@ NPC::NPC(const std::string& name,
          NPCType type)
     : Entity(name, description),
       type_(type),
+      current_state_(DialogueState::INITIAL),
       has_quest_(false),
       quest_completed_(false) {
     
@@ -122,14 +123,14 @@ std::string NPC::getResponse(const std::string& keyword) const {
 }
 
 bool NPC::canInteractWith(const std::string& itemId) const {
-    return interaction_items_.find(itemId) != interaction_items_.end();
+    return interaction_items_.find(SymbolTable::global().find(itemId)) != interaction_items_.end();
 }
 
 void NPC::addItemInteraction(const std::string& itemId, const std::string& response) {
-    interaction_items_[itemId] = response;
+    interaction_items_[SymbolTable::global().intern(itemId)] = response;
 }
 
 std::string NPC::getItemInteraction(const std::string& itemId) const {
-    auto it = interaction_items_.find(itemId);
+    auto it = interaction_items_.find(SymbolTable::global().find(itemId));
     return (it != interaction_items_.end()) ? it->second : "";
 }
\ No newline at end of file
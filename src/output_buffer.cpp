@@ -0,0 +1,43 @@
+#include "output_buffer.h"
+#include <cerrno>
+#include <sys/uio.h>
+#include <vector>
+
+bool writeFully(int fd, std::initializer_list<std::string_view> parts) {
+    iovec vectors[8];
+    std::vector<iovec> overflow;
+    iovec* iov = vectors;
+    if (parts.size() > sizeof(vectors) / sizeof(vectors[0])) {
+        overflow.resize(parts.size());
+        iov = overflow.data();
+    }
+
+    int count = 0;
+    for (std::string_view part : parts) {
+        if (part.empty()) continue;
+        iov[count].iov_base = const_cast<char*>(part.data());
+        iov[count].iov_len = part.size();
+        ++count;
+    }
+
+    while (count > 0) {
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        // Skip over what was written, possibly ending inside a piece
+        size_t remaining = static_cast<size_t>(written);
+        while (count > 0 && remaining >= iov->iov_len) {
+            remaining -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+    return true;
+}
@@ -17,10 +17,14 @@ bool Player::addItem(std::shared_ptr<Item> item) {
     return true;
 }
 
-bool Player::removeItem(const std::string& itemName) {
+bool Player::removeItem(std::string_view itemName) {
+    return removeItem(SymbolTable::global().find(itemName));
+}
+
+bool Player::removeItem(Symbol name) {
     auto it = std::find_if(inventory_.begin(), inventory_.end(),
-        [&itemName](const std::shared_ptr<Item>& item) {
-            return item->getName() == itemName;
+        [name](const std::shared_ptr<Item>& item) {
+            return item->isNamed(name);
         });
 
     if (it != inventory_.end()) {
@@ -30,28 +34,37 @@ bool Player::removeItem(const std::string& itemName) {
     return false;
 }
 
-std::shared_ptr<Item> Player::getItem(const std::string& itemName) const {
+std::shared_ptr<Item> Player::getItem(std::string_view itemName) const {
+    return getItem(SymbolTable::global().find(itemName));
+}
+
+std::shared_ptr<Item> Player::getItem(Symbol name) const {
     auto it = std::find_if(inventory_.begin(), inventory_.end(),
-        [&itemName](const std::shared_ptr<Item>& item) {
-            return item->getName() == itemName;
+        [name](const std::shared_ptr<Item>& item) {
+            return item->isNamed(name);
         });
 
     return (it != inventory_.end()) ? *it : nullptr;
 }
 
-std::string Player::getInventoryDescription() const {
-    if (inventory_.empty()) {
-        return "";
-    }
+bool Player::hasItem(std::string_view itemName) const {
+    return getItem(itemName) != nullptr;
+}
 
-    std::ostringstream oss;
+bool Player::hasItem(Symbol name) const {
+    return getItem(name) != nullptr;
+}
+
+std::pmr::string Player::getInventoryDescription(std::pmr::memory_resource* memory) const {
+    std::pmr::string description(memory);
     for (const auto& item : inventory_) {
-        oss << "- " << item->getName() << ": " << item->getDescription() << "\n";
+        description.append("- ").append(item->getName()).append(": ")
+                   .append(item->getDescription()).append("\n");
     }
-    return oss.str();
+    return description;
 }
 
-bool Player::useItem(const std::string& itemId) {
+bool Player::useItem(std::string_view itemId) {
     auto item = getItem(itemId);
     if (!item) {
         return false;
@@ -91,7 +104,9 @@ std::string Player::getStatus() const {
 }
 
 std::string Player::Examine() const {
-    return Entity::Examine() + "\n" + getInventoryDescription();
+    std::string description = Entity::Examine() + "\n";
+    description.append(getInventoryDescription());
+    return description;
 }
 
 void Player::reset() {
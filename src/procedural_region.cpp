@@ -0,0 +1,160 @@
+#include "procedural_region.h"
+#include <algorithm>
+#include <cstdlib>
+#include <span>
+#include <stdexcept>
+
+namespace {
+
+struct Terrain {
+    const char* name;
+    const char* description;
+};
+
+constexpr Terrain kMarshTerrain[] = {
+    {"Reed Beds", "Tall reeds whisper on every side, hiding the way ahead."},
+    {"Sunken Path", "Old planks sink under your weight into the black water."},
+    {"Bog Pool", "A still, dark pool reflects a sky the colour of ash."},
+    {"Misty Hummock", "A low rise of firm ground, wrapped in drifting mist."},
+    {"Drowned Grove", "Dead trees stand knee-deep in the marsh, bare and grey."},
+    {"Will-o'-Wisp Hollow", "Pale lights bob among the sedges and vanish when you look."},
+};
+
+constexpr Terrain kMountainTerrain[] = {
+    {"Scree Slope", "Loose stones slide underfoot on the steep hillside."},
+    {"Windswept Ridge", "The wind howls along a narrow ridge of bare rock."},
+    {"Hidden Valley", "A sheltered valley of short grass between high cliffs."},
+    {"Frozen Tarn", "A small lake lies frozen beneath the peaks."},
+    {"Goat Track", "A thin track winds between boulders, worn by hooves."},
+    {"Echoing Gorge", "Every step comes back to you from the walls of the gorge."},
+};
+
+// SplitMix64 finalizer: a cheap hash whose output bits all depend on every input bit
+uint64_t mix(uint64_t value) {
+    value += 0x9e3779b97f4a7c15;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+    return value ^ (value >> 31);
+}
+
+std::span<const Terrain> terrainOf(EnvironmentType type) {
+    if (type == EnvironmentType::MOUNTAIN_WILDS) {
+        return kMountainTerrain;
+    }
+    return kMarshTerrain;
+}
+
+}  // namespace
+
+ProceduralRegion::ProceduralRegion(EnvironmentType type, uint64_t seed, LocationGrid& grid, LocationStore& store)
+    : type_(type), seed_(seed), grid_(grid), store_(store) {
+    if (!isProcedural(type)) {
+        throw std::invalid_argument("Environment type is not procedural");
+    }
+}
+
+Location* ProceduralRegion::materialize(int x, int y) {
+    if (x < 0 || x >= grid_.getWidth() || y < 0 || y >= grid_.getHeight()) {
+        return nullptr;
+    }
+    int chunkX = x / LocationGrid::CHUNK_SIZE;
+    int chunkY = y / LocationGrid::CHUNK_SIZE;
+    if (!findResident(chunkX, chunkY)) {
+        generate(chunkX, chunkY);
+    }
+    return grid_.getLocation(x, y);
+}
+
+Location* ProceduralRegion::anchor(int x, int y) {
+    Location* location = materialize(x, y);
+    if (location) {
+        findResident(x / LocationGrid::CHUNK_SIZE, y / LocationGrid::CHUNK_SIZE)->pinned = true;
+    }
+    return location;
+}
+
+void ProceduralRegion::approach(int x, int y) {
+    int centreX = x / LocationGrid::CHUNK_SIZE;
+    int centreY = y / LocationGrid::CHUNK_SIZE;
+
+    for (int chunkY = centreY - ACTIVE_RADIUS; chunkY <= centreY + ACTIVE_RADIUS; ++chunkY) {
+        for (int chunkX = centreX - ACTIVE_RADIUS; chunkX <= centreX + ACTIVE_RADIUS; ++chunkX) {
+            if (!findResident(chunkX, chunkY)) {
+                generate(chunkX, chunkY);
+            }
+        }
+    }
+
+    // Chunks between the two radii stay, so walking along a chunk edge
+    // does not generate and evict the same chunks over and over
+    auto evicted = std::stable_partition(resident_.begin(), resident_.end(), [&](const ResidentChunk& chunk) {
+        return std::max(std::abs(chunk.chunkX - centreX), std::abs(chunk.chunkY - centreY)) <= EVICT_RADIUS ||
+               chunk.pinned || isModified(chunk);
+    });
+    for (auto it = evicted; it != resident_.end(); ++it) {
+        evict(*it);
+    }
+    resident_.erase(evicted, resident_.end());
+}
+
+ProceduralRegion::ResidentChunk* ProceduralRegion::findResident(int chunkX, int chunkY) {
+    auto it = std::find_if(resident_.begin(), resident_.end(), [&](const ResidentChunk& chunk) {
+        return chunk.chunkX == chunkX && chunk.chunkY == chunkY;
+    });
+    return it != resident_.end() ? &*it : nullptr;
+}
+
+ProceduralRegion::ResidentChunk* ProceduralRegion::generate(int chunkX, int chunkY) {
+    int originX = chunkX * LocationGrid::CHUNK_SIZE;
+    int originY = chunkY * LocationGrid::CHUNK_SIZE;
+    if (chunkX < 0 || chunkY < 0 || originX >= grid_.getWidth() || originY >= grid_.getHeight()) {
+        return nullptr;
+    }
+
+    // Each cell depends only on the seed and its own coordinates
+    std::span<const Terrain> terrain = terrainOf(type_);
+    uint64_t chunkSeed = mix(seed_ ^ mix((uint64_t(uint32_t(chunkX)) << 32) | uint32_t(chunkY)));
+    int endX = std::min(originX + LocationGrid::CHUNK_SIZE, grid_.getWidth());
+    int endY = std::min(originY + LocationGrid::CHUNK_SIZE, grid_.getHeight());
+    for (int y = originY; y < endY; ++y) {
+        for (int x = originX; x < endX; ++x) {
+            uint64_t cell = static_cast<uint64_t>((y - originY) * LocationGrid::CHUNK_SIZE + (x - originX));
+            const Terrain& kind = terrain[mix(chunkSeed + cell) % terrain.size()];
+            Location* location = store_.create(kind.name, kind.description);
+            grid_.setLocation(x, y, location);
+            store_.setPlacement(location->getId(), &grid_, x, y);
+        }
+    }
+    grid_.connectChunk(chunkX, chunkY);
+
+    resident_.push_back(ResidentChunk{chunkX, chunkY, false});
+    return &resident_.back();
+}
+
+bool ProceduralRegion::isModified(const ResidentChunk& chunk) const {
+    int originX = chunk.chunkX * LocationGrid::CHUNK_SIZE;
+    int originY = chunk.chunkY * LocationGrid::CHUNK_SIZE;
+    for (int y = originY; y < originY + LocationGrid::CHUNK_SIZE; ++y) {
+        for (int x = originX; x < originX + LocationGrid::CHUNK_SIZE; ++x) {
+            const Location* location = grid_.getLocation(x, y);
+            if (location && (!location->getItems().empty() || !location->getNPCs().empty() ||
+                             location->getPuzzle())) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ProceduralRegion::evict(const ResidentChunk& chunk) {
+    int originX = chunk.chunkX * LocationGrid::CHUNK_SIZE;
+    int originY = chunk.chunkY * LocationGrid::CHUNK_SIZE;
+    for (int y = originY; y < originY + LocationGrid::CHUNK_SIZE; ++y) {
+        for (int x = originX; x < originX + LocationGrid::CHUNK_SIZE; ++x) {
+            if (const Location* location = grid_.getLocation(x, y)) {
+                store_.destroy(location->getId());
+            }
+        }
+    }
+    grid_.releaseChunk(chunk.chunkX, chunk.chunkY);
+}
@@ -55,6 +55,15 @@ int Puzzle::GetAttemptsRemaining() const {
     return max_attempts_ - attempts_;
 }
 
+int Puzzle::GetAttempts() const {
+    return attempts_;
+}
+
+void Puzzle::RestoreProgress(PuzzleState state, int attempts) {
+    state_ = state;
+    attempts_ = attempts;
+}
+
 void Puzzle::SetState(PuzzleState new_state) {
     state_ = new_state;
 }
@@ -31,7 +31,7 @@ ReflectionPuzzle::ReflectionPuzzle(const std::string& name,
     }
 }
 
-bool ReflectionPuzzle::AttemptSolution(const std::string& /* attempt */) {
+bool ReflectionPuzzle::AttemptSolution(std::string_view /* attempt */) {
     if (!CanAttempt()) {
         throw PuzzleException("Cannot attempt puzzle without Crystal Lens");
     }
@@ -44,7 +44,7 @@ bool ReflectionPuzzle::AttemptSolution(const std::string& /* attempt */) {
     return solved;
 }
 
-std::string ReflectionPuzzle::GetHint() const {
+std::string_view ReflectionPuzzle::GetHint() const {
     if (!has_crystal_lens_) {
         return "You need the Crystal Lens to attempt this puzzle.";
     }
@@ -156,6 +156,22 @@ void ReflectionPuzzle::SetHasLens(bool has_lens) {
     has_crystal_lens_ = has_lens;
 }
 
+bool ReflectionPuzzle::HasLens() const {
+    return has_crystal_lens_;
+}
+
+std::vector<PlacedMirror> ReflectionPuzzle::GetMirrors() const {
+    std::vector<PlacedMirror> mirrors;
+    for (int y = 0; y < GRID_SIZE; ++y) {
+        for (int x = 0; x < GRID_SIZE; ++x) {
+            if (grid_[y][x].has_value()) {
+                mirrors.push_back(PlacedMirror{x, y, grid_[y][x]->rotation});
+            }
+        }
+    }
+    return mirrors;
+}
+
 LightBeam ReflectionPuzzle::CalculateReflection(const LightBeam& beam, 
                                                const Mirror& mirror) {
     // Convert rotation to radians
@@ -18,17 +18,16 @@ RiddlePuzzle::RiddlePuzzle(const std::string& name,
     }
 }
 
-bool RiddlePuzzle::AttemptSolution(const std::string& attempt) {
+bool RiddlePuzzle::AttemptSolution(std::string_view attempt) {
     if (!CanAttempt()) {
         throw PuzzleException("Cannot attempt puzzle: " + GetName());
     }
 
-    std::string normalized_attempt = NormalizeString(attempt);
-    
     // Check if the attempt matches any correct answer
-    bool is_correct = std::find(correct_answers_.begin(),
-                               correct_answers_.end(),
-                               normalized_attempt) != correct_answers_.end();
+    bool is_correct = std::any_of(correct_answers_.begin(), correct_answers_.end(),
+                                  [attempt](const std::string& answer) {
+                                      return MatchesAnswer(attempt, answer);
+                                  });
 
     IncrementAttempts();
     
@@ -40,7 +39,7 @@ bool RiddlePuzzle::AttemptSolution(const std::string& attempt) {
     return false;
 }
 
-std::string RiddlePuzzle::GetHint() const {
+std::string_view RiddlePuzzle::GetHint() const {
     return hint_;
 }
 
@@ -58,4 +57,18 @@ std::string RiddlePuzzle::NormalizeString(const std::string& str) {
     result.erase(result.find_last_not_of(" \t\n\r\f\v") + 1);
     
     return result;
-}
\ No newline at end of file
+}
+
+bool RiddlePuzzle::MatchesAnswer(std::string_view attempt, const std::string& answer) {
+    // Trim the same whitespace as NormalizeString
+    constexpr std::string_view kWhitespace = " \t\n\r\f\v";
+    size_t first = attempt.find_first_not_of(kWhitespace);
+    if (first == std::string_view::npos) {
+        return answer.empty();
+    }
+    attempt = attempt.substr(first, attempt.find_last_not_of(kWhitespace) - first + 1);
+
+    return attempt.size() == answer.size() &&
+           std::equal(attempt.begin(), attempt.end(), answer.begin(),
+                      [](unsigned char c, char expected) { return std::tolower(c) == expected; });
+}
@@ -0,0 +1,393 @@
+#include "snapshot.h"
+#include "book_sorting_puzzle.h"
+#include "game_world.h"
+#include "item.h"
+#include "npc.h"
+#include "player.h"
+#include "reflection_puzzle.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// On-disk records. Everything is 4-byte aligned and in host byte order.
+
+struct LocationRef {
+    uint16_t environment;
+    uint16_t x;
+    uint16_t y;
+    uint16_t padding;
+};
+
+struct StringRef {
+    uint32_t offset;  // into the string table
+    uint32_t length;
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t fileSize;
+    LocationRef current;
+    uint32_t itemCount;
+    uint32_t npcCount;
+    uint32_t puzzleCount;
+    uint32_t mirrorCount;
+    uint32_t bookSlotCount;
+    uint32_t stringBytes;
+    uint32_t builtEnvironments;  // bit per environment index; the others are untouched
+};
+
+struct ItemRecord {
+    StringRef id;
+    LocationRef location;  // unused when inInventory is set
+    uint8_t inInventory;
+    uint8_t padding[3];
+};
+
+struct NpcRecord {
+    LocationRef location;
+    uint16_t index;  // position in the location's NPC list
+    uint8_t dialogueState;
+    uint8_t questCompleted;
+};
+
+struct PuzzleRecord {
+    LocationRef location;
+    int32_t attempts;
+    uint8_t state;
+    uint8_t hasLens;
+    uint16_t padding;
+    uint32_t firstMirror;
+    uint32_t mirrorCount;
+    uint32_t firstBookSlot;
+    uint32_t bookSlotCount;
+};
+
+struct MirrorRecord {
+    int8_t x;
+    int8_t y;
+    int16_t rotation;
+};
+
+struct BookSlotRecord {
+    StringRef bookId;  // empty for an empty slot
+};
+
+constexpr char kMagic[8] = {'E', 'L', 'D', 'S', 'N', 'A', 'P', '\0'};
+
+template <typename Record>
+void append(std::vector<char>& out, const Record& record) {
+    static_assert(std::is_trivially_copyable_v<Record>, "records must be plain data");
+    const char* bytes = reinterpret_cast<const char*>(&record);
+    out.insert(out.end(), bytes, bytes + sizeof(Record));
+}
+
+std::runtime_error invalid(const std::string& path, const std::string& why) {
+    return std::runtime_error("Invalid snapshot " + path + ": " + why);
+}
+
+// Visit every location of the built environments with its stable reference;
+// environments never built are still as the builder made them
+void forEachLocation(const GameWorld& world,
+                     const std::function<void(LocationRef, Location*)>& visit) {
+    for (size_t env = 0; env < world.getEnvironmentCount(); ++env) {
+        LocationGrid* grid = world.findEnvironment(env);
+        if (!grid) continue;
+        grid->forEachLocation([&](int x, int y, Location* location) {
+            visit(LocationRef{static_cast<uint16_t>(env),
+                              static_cast<uint16_t>(x),
+                              static_cast<uint16_t>(y), 0},
+                  location);
+        });
+    }
+}
+
+// Read-only mapping of a whole file, unmapped on destruction
+class MappedFile {
+ public:
+    explicit MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open snapshot " + path + ": " + std::strerror(errno));
+        }
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            size_ = static_cast<size_t>(info.st_size);
+            void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            data_ = mapped == MAP_FAILED ? nullptr : static_cast<const char*>(mapped);
+        }
+        close(fd);
+        if (!data_) {
+            throw std::runtime_error("Cannot map snapshot " + path);
+        }
+    }
+
+    ~MappedFile() { munmap(const_cast<char*>(data_), size_); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+ private:
+    const char* data_;
+    size_t size_;
+};
+
+}  // namespace
+
+void Snapshot::save(const GameWorld& world, const Player& player, const std::string& path) {
+    std::vector<char> items, npcs, puzzles, mirrors, bookSlots;
+    std::string strings;
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    if (world.getEnvironmentCount() > 32) {
+        throw std::runtime_error("Cannot write snapshot " + path + ": too many environments");
+    }
+    for (size_t env = 0; env < world.getEnvironmentCount(); ++env) {
+        if (world.findEnvironment(env)) {
+            header.builtEnvironments |= uint32_t{1} << env;
+        }
+    }
+
+    auto addString = [&strings](const std::string& text) {
+        StringRef ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(text.size())};
+        strings += text;
+        return ref;
+    };
+
+    forEachLocation(world, [&](LocationRef ref, Location* location) {
+        if (location == world.getCurrentLocation()) {
+            header.current = ref;
+        }
+
+        for (const auto& item : location->getItems()) {
+            append(items, ItemRecord{addString(item->GetItemId()), ref, 0, {}});
+            ++header.itemCount;
+        }
+
+        const auto& locationNpcs = location->getNPCs();
+        for (size_t i = 0; i < locationNpcs.size(); ++i) {
+            append(npcs, NpcRecord{ref, static_cast<uint16_t>(i),
+                                   static_cast<uint8_t>(locationNpcs[i]->getState()),
+                                   static_cast<uint8_t>(locationNpcs[i]->isQuestCompleted())});
+            ++header.npcCount;
+        }
+
+        if (auto puzzle = location->getPuzzle()) {
+            PuzzleRecord record{};
+            record.location = ref;
+            record.attempts = puzzle->GetAttempts();
+            record.state = static_cast<uint8_t>(puzzle->GetState());
+            record.firstMirror = header.mirrorCount;
+            record.firstBookSlot = header.bookSlotCount;
+
+            if (auto reflection = std::dynamic_pointer_cast<ReflectionPuzzle>(puzzle)) {
+                record.hasLens = reflection->HasLens();
+                for (const auto& mirror : reflection->GetMirrors()) {
+                    append(mirrors, MirrorRecord{static_cast<int8_t>(mirror.x),
+                                                 static_cast<int8_t>(mirror.y),
+                                                 static_cast<int16_t>(mirror.rotation)});
+                    ++record.mirrorCount;
+                }
+            }
+            if (auto books = std::dynamic_pointer_cast<BookSortingPuzzle>(puzzle)) {
+                for (const auto& bookId : books->GetCurrentArrangement()) {
+                    append(bookSlots, BookSlotRecord{addString(bookId)});
+                    ++record.bookSlotCount;
+                }
+            }
+
+            header.mirrorCount += record.mirrorCount;
+            header.bookSlotCount += record.bookSlotCount;
+            append(puzzles, record);
+            ++header.puzzleCount;
+        }
+    });
+
+    for (const auto& item : player.getInventory()) {
+        append(items, ItemRecord{addString(item->GetItemId()), LocationRef{}, 1, {}});
+        ++header.itemCount;
+    }
+
+    // Keep the file size a multiple of 4 like every record
+    strings.resize((strings.size() + 3) & ~size_t{3}, '\0');
+    header.stringBytes = static_cast<uint32_t>(strings.size());
+
+    std::vector<char> file;
+    append(file, header);
+    for (const auto* section : {&items, &npcs, &puzzles, &mirrors, &bookSlots}) {
+        file.insert(file.end(), section->begin(), section->end());
+    }
+    file.insert(file.end(), strings.begin(), strings.end());
+    reinterpret_cast<Header*>(file.data())->fileSize = static_cast<uint32_t>(file.size());
+
+    std::string temporary = path + ".tmp";
+    int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot write snapshot " + path + ": " + std::strerror(errno));
+    }
+    size_t written = 0;
+    while (written < file.size()) {
+        ssize_t result = write(fd, file.data() + written, file.size() - written);
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) break;
+        written += static_cast<size_t>(result);
+    }
+    bool ok = written == file.size() && fsync(fd) == 0;
+    close(fd);
+    if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        unlink(temporary.c_str());
+        throw std::runtime_error("Cannot write snapshot " + path + ": " + std::strerror(errno));
+    }
+}
+
+void Snapshot::load(GameWorld& world, Player& player, const std::string& path) {
+    MappedFile file(path);
+
+    if (file.size() < sizeof(Header)) {
+        throw invalid(path, "truncated header");
+    }
+    const Header& header = *reinterpret_cast<const Header*>(file.data());
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw invalid(path, "not a snapshot");
+    }
+    if (header.version != kVersion) {
+        throw invalid(path, "unsupported version " + std::to_string(header.version));
+    }
+
+    // Section layout follows from the counts; check it fits before touching records
+    uint64_t expected = sizeof(Header)
+        + uint64_t{header.itemCount} * sizeof(ItemRecord)
+        + uint64_t{header.npcCount} * sizeof(NpcRecord)
+        + uint64_t{header.puzzleCount} * sizeof(PuzzleRecord)
+        + uint64_t{header.mirrorCount} * sizeof(MirrorRecord)
+        + uint64_t{header.bookSlotCount} * sizeof(BookSlotRecord)
+        + header.stringBytes;
+    if (header.fileSize != file.size() || expected != file.size()) {
+        throw invalid(path, "size mismatch");
+    }
+
+    const char* cursor = file.data() + sizeof(Header);
+    auto section = [&cursor](auto* type, uint32_t count) {
+        using Record = std::remove_pointer_t<decltype(type)>;
+        const Record* records = reinterpret_cast<const Record*>(cursor);
+        cursor += count * sizeof(Record);
+        return records;
+    };
+    const ItemRecord* items = section(static_cast<ItemRecord*>(nullptr), header.itemCount);
+    const NpcRecord* npcs = section(static_cast<NpcRecord*>(nullptr), header.npcCount);
+    const PuzzleRecord* puzzles = section(static_cast<PuzzleRecord*>(nullptr), header.puzzleCount);
+    const MirrorRecord* mirrors = section(static_cast<MirrorRecord*>(nullptr), header.mirrorCount);
+    const BookSlotRecord* bookSlots = section(static_cast<BookSlotRecord*>(nullptr), header.bookSlotCount);
+    std::string_view strings(cursor, header.stringBytes);
+
+    auto text = [&](StringRef ref) {
+        if (uint64_t{ref.offset} + ref.length > strings.size()) {
+            throw invalid(path, "string out of range");
+        }
+        return strings.substr(ref.offset, ref.length);
+    };
+    auto locate = [&](LocationRef ref) {
+        // Generates the cell if it lies in a procedural region that was not
+        // materialized in the fresh world
+        Location* location = world.getLocation(ref.environment, ref.x, ref.y);
+        if (!location) {
+            throw invalid(path, "unknown location");
+        }
+        return location;
+    };
+
+    // Build what the saved world had built, so that the items of those
+    // environments are gathered below rather than reappearing later
+    for (size_t env = 0; env < 32; ++env) {
+        if ((header.builtEnvironments >> env & 1) && !world.getEnvironment(env)) {
+            throw invalid(path, "unknown environment");
+        }
+    }
+
+    // Gather every item of the fresh world by ID, then take them all out
+    std::unordered_map<Symbol, std::shared_ptr<Item>> itemsById;
+    forEachLocation(world, [&](LocationRef, Location* location) {
+        auto present = location->getItems();
+        for (const auto& item : present) {
+            itemsById[item->GetItemSymbol()] = item;
+            location->removeItem(item->getSymbol());
+        }
+    });
+    for (const auto& item : player.getInventory()) {
+        itemsById[item->GetItemSymbol()] = item;
+    }
+    player.reset();
+
+    // Put each item where the snapshot says it was
+    for (uint32_t i = 0; i < header.itemCount; ++i) {
+        auto it = itemsById.find(SymbolTable::global().find(text(items[i].id)));
+        if (it == itemsById.end()) {
+            throw invalid(path, "unknown item " + std::string(text(items[i].id)));
+        }
+        if (items[i].inInventory) {
+            player.addItem(it->second);
+        } else {
+            locate(items[i].location)->addItem(it->second);
+        }
+    }
+
+    for (uint32_t i = 0; i < header.npcCount; ++i) {
+        const auto& npcList = locate(npcs[i].location)->getNPCs();
+        if (npcs[i].index >= npcList.size()) {
+            throw invalid(path, "unknown NPC");
+        }
+        const auto& npc = npcList[npcs[i].index];
+        npc->setState(static_cast<DialogueState>(npcs[i].dialogueState));
+        if (npcs[i].questCompleted) {
+            npc->completeQuest();
+        }
+    }
+
+    for (uint32_t i = 0; i < header.puzzleCount; ++i) {
+        const PuzzleRecord& record = puzzles[i];
+        auto puzzle = locate(record.location)->getPuzzle();
+        if (!puzzle ||
+            uint64_t{record.firstMirror} + record.mirrorCount > header.mirrorCount ||
+            uint64_t{record.firstBookSlot} + record.bookSlotCount > header.bookSlotCount) {
+            throw invalid(path, "puzzle does not match the world");
+        }
+
+        puzzle->Reset();
+        if (auto reflection = std::dynamic_pointer_cast<ReflectionPuzzle>(puzzle)) {
+            reflection->SetHasLens(record.hasLens != 0);
+            for (uint32_t m = 0; m < record.mirrorCount; ++m) {
+                const MirrorRecord& mirror = mirrors[record.firstMirror + m];
+                reflection->PlaceMirror(mirror.x, mirror.y, mirror.rotation);
+            }
+        }
+        if (auto books = std::dynamic_pointer_cast<BookSortingPuzzle>(puzzle)) {
+            for (uint32_t b = 0; b < record.bookSlotCount && b < books->GetTotalPositions(); ++b) {
+                std::string_view bookId = text(bookSlots[record.firstBookSlot + b].bookId);
+                if (!bookId.empty()) {
+                    books->PlaceBook(std::string(bookId), b);
+                }
+            }
+        }
+        puzzle->RestoreProgress(static_cast<PuzzleState>(record.state), record.attempts);
+    }
+
+    if (!world.setCurrentLocation(header.current.environment, header.current.x, header.current.y)) {
+        throw invalid(path, "unknown current location");
+    }
+}
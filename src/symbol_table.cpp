@@ -0,0 +1,100 @@
+#include "symbol_table.h"
+#include <algorithm>
+
+namespace {
+
+unsigned char lowerByte(char c) {
+    unsigned char byte = static_cast<unsigned char>(c);
+    return byte >= 'A' && byte <= 'Z' ? byte + ('a' - 'A') : byte;
+}
+
+}  // namespace
+
+SymbolTable::Index::Index(size_t slotCount)
+    : mask(slotCount - 1), slots(std::make_unique<std::atomic<const Entry*>[]>(slotCount)) {}
+
+size_t SymbolTable::foldedHash(std::string_view text) {
+    // FNV-1a over the lowercased bytes
+    size_t hash = 14695981039346656037ull;
+    for (char c : text) {
+        hash = (hash ^ lowerByte(c)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+bool SymbolTable::foldedEqual(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(),
+                      [](char x, char y) { return lowerByte(x) == lowerByte(y); });
+}
+
+SymbolTable& SymbolTable::global() {
+    static SymbolTable table;
+    return table;
+}
+
+Symbol SymbolTable::intern(std::string_view text) {
+    // Worlds are rebuilt from the same names, so the symbol usually exists
+    if (Symbol symbol = find(text); symbol != kNoSymbol) {
+        return symbol;
+    }
+
+    std::lock_guard lock(mutex_);
+    size_t hash = foldedHash(text);
+    if (!indexes_.empty()) {
+        if (const Entry* entry = probe(*indexes_.back(), text, hash)) {
+            return entry->symbol;  // added by another thread meanwhile
+        }
+    }
+
+    // Keep the index at most half full so probe sequences stay short
+    size_t count = entries_.size() + 1;
+    if (indexes_.empty() || count * 2 > indexes_.back()->mask + 1) {
+        size_t slotCount = indexes_.empty() ? kInitialSlots : (indexes_.back()->mask + 1) * 2;
+        auto grown = std::make_unique<Index>(slotCount);
+        for (const Entry& entry : entries_) {
+            place(*grown, &entry);
+        }
+        index_.store(grown.get(), std::memory_order_release);
+        indexes_.push_back(std::move(grown));
+    }
+
+    const Entry& entry = entries_.emplace_back(Entry{hash, static_cast<Symbol>(count), std::string(text)});
+    place(*indexes_.back(), &entry);
+    count_.store(count, std::memory_order_release);
+    return entry.symbol;
+}
+
+Symbol SymbolTable::find(std::string_view text) const {
+    const Index* index = index_.load(std::memory_order_acquire);
+    if (!index) {
+        return kNoSymbol;
+    }
+    const Entry* entry = probe(*index, text, foldedHash(text));
+    return entry ? entry->symbol : kNoSymbol;
+}
+
+size_t SymbolTable::size() const {
+    return count_.load(std::memory_order_acquire);
+}
+
+const SymbolTable::Entry* SymbolTable::probe(const Index& index, std::string_view text, size_t hash) {
+    for (size_t slot = hash & index.mask;; slot = (slot + 1) & index.mask) {
+        const Entry* entry = index.slots[slot].load(std::memory_order_acquire);
+        if (!entry) {
+            return nullptr;
+        }
+        if (entry->hash == hash && foldedEqual(entry->name, text)) {
+            return entry;
+        }
+    }
+}
+
+void SymbolTable::place(Index& index, const Entry* entry) {
+    size_t slot = entry->hash & index.mask;
+    while (index.slots[slot].load(std::memory_order_relaxed)) {
+        slot = (slot + 1) & index.mask;
+    }
+    // Release: a reader that sees the pointer sees the whole entry
+    index.slots[slot].store(entry, std::memory_order_release);
+}
@@ -0,0 +1,236 @@
+#include "text_scan.h"
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TEXT_SCAN_X86 1
+#endif
+
+namespace {
+
+// Length of the well-formed UTF-8 sequence for a non-ASCII character at
+// text[i], or 0 if the bytes there are not one
+size_t utf8SequenceLength(std::string_view text, size_t i) {
+    auto byte = [&text](size_t at) { return static_cast<unsigned char>(text[at]); };
+    unsigned char lead = byte(i);
+    size_t length;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+
+    // Second-byte limits exclude overlong forms, surrogates and code points past U+10FFFF
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) low = 0xA0;
+        if (lead == 0xED) high = 0x9F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) low = 0x90;
+        if (lead == 0xF4) high = 0x8F;
+    } else {
+        return 0;
+    }
+
+    if (i + length > text.size() || byte(i + 1) < low || byte(i + 1) > high) {
+        return 0;
+    }
+    for (size_t k = 2; k < length; ++k) {
+        if ((byte(i + k) & 0xC0) != 0x80) return 0;
+    }
+    return length;
+}
+
+bool isCommandByte(char c) {
+    unsigned char lower = static_cast<unsigned char>(c) | 0x20;
+    return static_cast<unsigned char>(lower - 'a') < 26 ||
+           static_cast<unsigned char>(c - '0') < 10 || isAsciiSpace(c);
+}
+
+// Index of the first byte at or after i that isCommandByte() rejects
+size_t skipCommandBytesScalar(std::string_view text, size_t i) {
+    while (i < text.size() && isCommandByte(text[i])) ++i;
+    return i;
+}
+
+void foldAsciiScalar(char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        if (static_cast<unsigned char>(data[i] - 'A') < 26) data[i] += 0x20;
+    }
+}
+
+#ifdef TEXT_SCAN_X86
+
+// Inputs shorter than one AVX2 vector go straight to SSE2, so typical
+// commands never pay for waking the upper register halves
+bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+// (x - low) <= span as unsigned bytes: all-ones where x lies in [low, low + span]
+inline __m128i inRange(__m128i x, char low, char span) {
+    __m128i offset = _mm_sub_epi8(x, _mm_set1_epi8(low));
+    return _mm_cmpeq_epi8(_mm_subs_epu8(offset, _mm_set1_epi8(span)), _mm_setzero_si128());
+}
+
+__attribute__((target("avx2")))
+inline __m256i inRange(__m256i x, char low, char span) {
+    __m256i offset = _mm256_sub_epi8(x, _mm256_set1_epi8(low));
+    return _mm256_cmpeq_epi8(_mm256_subs_epu8(offset, _mm256_set1_epi8(span)), _mm256_setzero_si256());
+}
+
+size_t findByteSse2(std::string_view text, char byte, size_t i) {
+    __m128i needle = _mm_set1_epi8(byte);
+    for (; i + 16 <= text.size(); i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+        if (int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle))) {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+    for (; i < text.size(); ++i) {
+        if (text[i] == byte) return i;
+    }
+    return std::string_view::npos;
+}
+
+__attribute__((target("avx2")))
+size_t findByteAvx2(std::string_view text, char byte, size_t i) {
+    __m256i needle = _mm256_set1_epi8(byte);
+    for (; i + 32 <= text.size(); i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + i));
+        if (uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)))) {
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+    // Legacy SSE code after dirty upper halves costs a state transition
+    _mm256_zeroupper();
+    return findByteSse2(text, byte, i);
+}
+
+size_t skipCommandBytesSse2(std::string_view text, size_t i) {
+    for (; i + 16 <= text.size(); i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+        __m128i letters = inRange(_mm_or_si128(chunk, _mm_set1_epi8(0x20)), 'a', 25);
+        __m128i digits = inRange(chunk, '0', 9);
+        __m128i spaces = _mm_or_si128(inRange(chunk, '\t', 4), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')));
+        __m128i allowed = _mm_or_si128(_mm_or_si128(letters, digits), spaces);
+        unsigned rejected = ~static_cast<unsigned>(_mm_movemask_epi8(allowed)) & 0xFFFFu;
+        if (rejected) {
+            return i + static_cast<size_t>(__builtin_ctz(rejected));
+        }
+    }
+    return skipCommandBytesScalar(text, i);
+}
+
+__attribute__((target("avx2")))
+size_t skipCommandBytesAvx2(std::string_view text, size_t i) {
+    for (; i + 32 <= text.size(); i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + i));
+        __m256i letters = inRange(_mm256_or_si256(chunk, _mm256_set1_epi8(0x20)), 'a', 25);
+        __m256i digits = inRange(chunk, '0', 9);
+        __m256i spaces = _mm256_or_si256(inRange(chunk, '\t', 4),
+                                         _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')));
+        __m256i allowed = _mm256_or_si256(_mm256_or_si256(letters, digits), spaces);
+        uint32_t rejected = ~static_cast<uint32_t>(_mm256_movemask_epi8(allowed));
+        if (rejected) {
+            return i + static_cast<size_t>(__builtin_ctz(rejected));
+        }
+    }
+    _mm256_zeroupper();
+    return skipCommandBytesSse2(text, i);
+}
+
+// Returns true if any byte was non-ASCII
+bool foldAsciiSse2(char* data, size_t size, size_t& i) {
+    __m128i highBits = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16) {
+        auto* at = reinterpret_cast<__m128i*>(data + i);
+        __m128i chunk = _mm_loadu_si128(at);
+        __m128i upper = inRange(chunk, 'A', 25);
+        _mm_storeu_si128(at, _mm_add_epi8(chunk, _mm_and_si128(upper, _mm_set1_epi8(0x20))));
+        highBits = _mm_or_si128(highBits, chunk);
+    }
+    return _mm_movemask_epi8(highBits) != 0;
+}
+
+__attribute__((target("avx2")))
+bool foldAsciiAvx2(char* data, size_t size, size_t& i) {
+    __m256i highBits = _mm256_setzero_si256();
+    for (; i + 32 <= size; i += 32) {
+        auto* at = reinterpret_cast<__m256i*>(data + i);
+        __m256i chunk = _mm256_loadu_si256(at);
+        __m256i upper = inRange(chunk, 'A', 25);
+        _mm256_storeu_si256(at, _mm256_add_epi8(chunk, _mm256_and_si256(upper, _mm256_set1_epi8(0x20))));
+        highBits = _mm256_or_si256(highBits, chunk);
+    }
+    bool nonAscii = _mm256_movemask_epi8(highBits) != 0;
+    _mm256_zeroupper();
+    return foldAsciiSse2(data, size, i) || nonAscii;
+}
+
+#endif  // TEXT_SCAN_X86
+
+size_t skipCommandBytes(std::string_view text, size_t i) {
+#ifdef TEXT_SCAN_X86
+    return text.size() - i >= 32 && hasAvx2() ? skipCommandBytesAvx2(text, i) : skipCommandBytesSse2(text, i);
+#else
+    return skipCommandBytesScalar(text, i);
+#endif
+}
+
+}  // namespace
+
+size_t findByte(std::string_view text, char byte, size_t from) {
+#ifdef TEXT_SCAN_X86
+    return from + 32 <= text.size() && hasAvx2() ? findByteAvx2(text, byte, from) : findByteSse2(text, byte, from);
+#else
+    return text.find(byte, from);
+#endif
+}
+
+bool isCommandText(std::string_view text) {
+    size_t i = 0;
+    while ((i = skipCommandBytes(text, i)) < text.size()) {
+        // Stopped on punctuation or a control character, or on a
+        // non-ASCII character that must be well-formed UTF-8
+        if (static_cast<unsigned char>(text[i]) < 0x80) {
+            return false;
+        }
+        size_t length = utf8SequenceLength(text, i);
+        if (length == 0) {
+            return false;
+        }
+        i += length;
+    }
+    return true;
+}
+
+void foldCase(std::span<char> text) {
+    char* data = text.data();
+    size_t size = text.size();
+    size_t i = 0;
+    bool nonAscii = false;
+#ifdef TEXT_SCAN_X86
+    nonAscii = size >= 32 && hasAvx2() ? foldAsciiAvx2(data, size, i) : foldAsciiSse2(data, size, i);
+#endif
+    for (size_t k = i; k < size; ++k) {
+        nonAscii = nonAscii || static_cast<unsigned char>(data[k]) >= 0x80;
+    }
+    foldAsciiScalar(data + i, size - i);
+    if (!nonAscii) {
+        return;
+    }
+
+    // U+00C0..U+00DE (except U+00D7, the multiplication sign) are C3 80..C3 9E;
+    // their lowercase forms are 0x20 higher in the second byte. 0xC3 is
+    // never a continuation byte, so it always starts a character
+    for (size_t k = 0; k + 1 < size; ++k) {
+        auto second = static_cast<unsigned char>(data[k + 1]);
+        if (static_cast<unsigned char>(data[k]) == 0xC3 && second >= 0x80 && second <= 0x9E &&
+            second != 0x97) {
+            data[k + 1] = static_cast<char>(second + 0x20);
+            ++k;
+        }
+    }
+}
@@ -0,0 +1,165 @@
+#include "turn_scheduler.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// Index of the worker running on this thread, or kNotAWorker
+constexpr size_t kNotAWorker = static_cast<size_t>(-1);
+thread_local size_t currentWorker = kNotAWorker;
+thread_local const void* currentScheduler = nullptr;
+
+}  // namespace
+
+TurnScheduler::TurnScheduler(size_t workerCount)
+    : nextWorker_(0), pending_(0), idlePending_(0), stopping_(false) {
+    if (workerCount == 0) {
+        workerCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    workers_.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers_[i]->thread = std::thread(&TurnScheduler::workerLoop, this, i);
+    }
+}
+
+TurnScheduler::~TurnScheduler() {
+    shutdown();
+}
+
+void TurnScheduler::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(idleMutex_);
+        stopping_ = true;
+    }
+    idleCondition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void TurnScheduler::submit(Task task) {
+    enqueue(std::move(task), false);
+}
+
+void TurnScheduler::requeue(Task task) {
+    enqueue(std::move(task), true);
+}
+
+void TurnScheduler::enqueue(Task task, bool behind) {
+    // Work submitted by a worker stays local; outside work is spread out
+    bool local = currentScheduler == this;
+    size_t index = local
+        ? currentWorker
+        : nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        // Only the owner's own follow-up work jumps the line
+        if (local && !behind) {
+            workers_[index]->tasks.push_back(std::move(task));
+        } else {
+            workers_[index]->inbox.push_back(std::move(task));
+        }
+    }
+    pending_.fetch_add(1, std::memory_order_release);
+
+    // Taking the idle mutex orders this wake-up after a sleeper's final check
+    { std::lock_guard<std::mutex> lock(idleMutex_); }
+    idleCondition_.notify_one();
+}
+
+void TurnScheduler::submitIdle(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(idleTasksMutex_);
+        idleTasks_.push_back(std::move(task));
+    }
+    idlePending_.fetch_add(1, std::memory_order_release);
+
+    { std::lock_guard<std::mutex> lock(idleMutex_); }
+    idleCondition_.notify_one();
+}
+
+void TurnScheduler::workerLoop(size_t index) {
+    currentWorker = index;
+    currentScheduler = this;
+
+    Task task;
+    while (true) {
+        if (findTask(index, task) || findIdleTask(task)) {
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "Error running scheduled turn: " << e.what() << std::endl;
+            }
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idleMutex_);
+        idleCondition_.wait(lock, [this] {
+            return stopping_ || pending_.load(std::memory_order_acquire) > 0 ||
+                   idlePending_.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping_ && pending_.load(std::memory_order_acquire) == 0 &&
+            idlePending_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+bool TurnScheduler::findTask(size_t index, Task& task) {
+    // Newest local task first, then the oldest in the inbox
+    {
+        Worker& self = *workers_[index];
+        std::lock_guard<std::mutex> lock(self.mutex);
+        if (!self.tasks.empty()) {
+            task = std::move(self.tasks.back());
+            self.tasks.pop_back();
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        if (!self.inbox.empty()) {
+            task = std::move(self.inbox.front());
+            self.inbox.pop_front();
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Steal the oldest task from the other workers, inbox first: it holds
+    // the work that has waited longest
+    for (size_t offset = 1; offset < workers_.size(); ++offset) {
+        Worker& victim = *workers_[(index + offset) % workers_.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) continue;
+        std::deque<Task>& queue = victim.inbox.empty() ? victim.tasks : victim.inbox;
+        if (!queue.empty()) {
+            task = std::move(queue.front());
+            queue.pop_front();
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TurnScheduler::findIdleTask(Task& task) {
+    if (idlePending_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(idleTasksMutex_);
+    if (idleTasks_.empty()) {
+        return false;
+    }
+    task = std::move(idleTasks_.front());
+    idleTasks_.pop_front();
+    idlePending_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,99 @@
+#include "world_content.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+std::runtime_error contentError(int lineNumber, const std::string& what) {
+    return std::runtime_error("Content error at line " + std::to_string(lineNumber) + ": " + what);
+}
+
+}  // namespace
+
+std::unique_ptr<const WorldContent> WorldContent::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open content file " + path);
+    }
+    return parse(in);
+}
+
+std::unique_ptr<const WorldContent> WorldContent::parse(std::istream& in) {
+    auto content = std::make_unique<WorldContent>();
+    LocationText* location = nullptr;
+    std::string* item = nullptr;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        if (line.front() == '[') {
+            if (line.back() != ']') {
+                throw contentError(lineNumber, "unterminated section header");
+            }
+            std::string header = trim(line.substr(1, line.size() - 2));
+            size_t space = header.find(' ');
+            std::string kind = header.substr(0, space);
+            std::string name = space == std::string::npos ? "" : trim(header.substr(space + 1));
+            if (name.empty()) {
+                throw contentError(lineNumber, "section has no name");
+            }
+
+            location = nullptr;
+            item = nullptr;
+            if (kind == "location") {
+                location = &content->locations_[name];
+                location->name = name;
+            } else if (kind == "item") {
+                item = &content->items_[name];
+            } else {
+                throw contentError(lineNumber, "unknown section '" + kind + "'");
+            }
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            throw contentError(lineNumber, "expected 'key = value'");
+        }
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+
+        if (location && key == "name") {
+            location->name = value;
+        } else if (location && key == "description") {
+            location->description = value;
+        } else if (item && key == "description") {
+            *item = value;
+        } else {
+            throw contentError(lineNumber, "unexpected key '" + key + "'");
+        }
+    }
+
+    return content;
+}
+
+const WorldContent::LocationText* WorldContent::findLocation(std::string_view name) const {
+    auto it = locations_.find(name);
+    return it != locations_.end() ? &it->second : nullptr;
+}
+
+const std::string* WorldContent::findItemDescription(std::string_view name) const {
+    auto it = items_.find(name);
+    return it != items_.end() && !it->second.empty() ? &it->second : nullptr;
+}
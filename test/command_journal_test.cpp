@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "command_journal.h"
+#include "game_engine.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+class CommandJournalTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        directory_ = "/tmp/eldoria_journal_test_" + std::to_string(getpid());
+        std::filesystem::remove_all(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::string directory_;
+};
+
+TEST_F(CommandJournalTest, ReplaysOnlyStateChangingTurns) {
+    {
+        GameEngine engine;
+        EXPECT_EQ(engine.openJournal(directory_), 0u);
+        engine.step("take quest scroll");
+        engine.step("look");
+        engine.step("go north");
+        engine.step("inventory");
+    }
+
+    CommandJournal::Recovery recovery = CommandJournal::recover(directory_);
+    EXPECT_EQ(recovery.checkpoint, 0u);
+    ASSERT_EQ(recovery.commands.size(), 2u);
+    EXPECT_EQ(recovery.commands[1], "go north");
+
+    GameEngine restored;
+    EXPECT_EQ(restored.openJournal(directory_), 2u);
+    std::string look(restored.step("look").output);
+    EXPECT_NE(look.find("Village Square"), std::string::npos);
+    std::string inventory(restored.step("inventory").output);
+    EXPECT_NE(inventory.find("Quest Scroll"), std::string::npos);
+}
+
+TEST_F(CommandJournalTest, CheckpointsAndIgnoresTornTail) {
+    {
+        GameEngine engine;
+        engine.openJournal(directory_, 2);
+        engine.step("take quest scroll");
+        engine.step("go north");
+        engine.step("go north");
+        engine.step("go north");
+        engine.step("solve");
+        engine.step("a tree");
+        engine.step("leave");
+    }
+
+    CommandJournal::Recovery recovery = CommandJournal::recover(directory_);
+    EXPECT_EQ(recovery.checkpoint, 3u);
+    EXPECT_TRUE(recovery.commands.empty());
+
+    // A crash in the middle of a write leaves a partial last line
+    {
+        std::ofstream log(directory_ + "/journal.log", std::ios::app);
+        log << "go sou";
+    }
+
+    GameEngine restored;
+    EXPECT_EQ(restored.openJournal(directory_, 2), 0u);
+    std::string look(restored.step("look").output);
+    EXPECT_NE(look.find("Hermit's Hollow"), std::string::npos);
+
+    restored.step("solve");
+    std::string answer(restored.step("a rock").output);
+    EXPECT_NE(answer.find("Attempts remaining: 1"), std::string::npos);
+}
+
+TEST_F(CommandJournalTest, QuitInBatchKeepsEarlierCommands) {
+    {
+        GameEngine engine;
+        engine.openJournal(directory_);
+        EXPECT_TRUE(engine.step("take quest scroll then quit").quit);
+    }
+
+    CommandJournal::Recovery recovery = CommandJournal::recover(directory_);
+    ASSERT_EQ(recovery.commands.size(), 1u);
+    EXPECT_EQ(recovery.commands[0], "take quest scroll");
+
+    GameEngine restored;
+    EXPECT_EQ(restored.openJournal(directory_), 1u);
+    EXPECT_TRUE(restored.isRunning());
+    std::string inventory(restored.step("inventory").output);
+    EXPECT_NE(inventory.find("Quest Scroll"), std::string::npos);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "command_parser.h"
+#include "game_engine.h"
+#include <string>
+
+TEST(CommandParserTest, SplitsLowercasesAndJoinsNoun) {
+    CommandParser parser;
+    auto command = parser.parseInput("  Take   the\tQuest  Scroll ");
+    ASSERT_TRUE(command.isValid);
+    EXPECT_EQ(command.action, "take");
+    ASSERT_EQ(command.arguments.size(), 3u);
+    EXPECT_EQ(command.arguments[2], "scroll");
+    EXPECT_EQ(command.noun, "quest scroll");
+
+    auto bare = parser.parseInput("LOOK");
+    ASSERT_TRUE(bare.isValid);
+    EXPECT_EQ(bare.action, "look");
+    EXPECT_TRUE(bare.arguments.empty());
+    EXPECT_TRUE(bare.noun.empty());
+}
+
+TEST(CommandParserTest, RejectsBlankInvalidAndOverlongInput) {
+    CommandParser parser;
+    EXPECT_FALSE(parser.parseInput("").isValid);
+    EXPECT_FALSE(parser.parseInput(" \t ").isValid);
+    EXPECT_FALSE(parser.parseInput("go north!").isValid);
+
+    std::string words;
+    for (size_t i = 0; i <= CommandParser::kMaxTokens; ++i) {
+        words += "a ";
+    }
+    EXPECT_FALSE(parser.parseInput(words).isValid);
+    EXPECT_EQ(parser.getError(), CommandParser::Error::kTooManyWords);
+    EXPECT_FALSE(parser.parseInput("go north!").isValid);
+    EXPECT_EQ(parser.getError(), CommandParser::Error::kInvalid);
+}
+
+TEST(CommandParserTest, ItemNamesMatchWhateverTheCase) {
+    GameEngine engine;
+    engine.start();
+    engine.step("take quest scroll");
+
+    std::string dropped(engine.step("DROP quest SCROLL").output);
+    EXPECT_NE(dropped.find("Dropped: Quest Scroll"), std::string::npos);
+}
+
+TEST(CommandParserTest, SplitsBatchesOnCommasAndConjunctions) {
+    CommandParser parser;
+    auto batch = parser.parseBatch("go north,go east, take Quest Scroll then look and");
+    ASSERT_EQ(batch.size(), 4u);
+    EXPECT_EQ(batch[0].noun, "north");
+    EXPECT_EQ(batch[1].noun, "east");
+    EXPECT_EQ(batch[2].action, "take");
+    EXPECT_EQ(batch[2].noun, "quest scroll");
+    EXPECT_EQ(batch[3].action, "look");
+    EXPECT_TRUE(batch[3].noun.empty());
+
+    EXPECT_FALSE(parser.parseInput("look, inventory").isValid);
+    EXPECT_TRUE(parser.parseBatch("look, inventory!").empty());
+    EXPECT_TRUE(parser.parseBatch(" , then").empty());
+
+    std::string looks = "look";
+    for (size_t i = 1; i < CommandParser::kMaxCommands; ++i) {
+        looks += ", look";
+    }
+    EXPECT_EQ(parser.parseBatch(looks).size(), CommandParser::kMaxCommands);
+    EXPECT_EQ(parser.getError(), CommandParser::Error::kNone);
+    EXPECT_TRUE(parser.parseBatch(looks + ", look").empty());
+    EXPECT_EQ(parser.getError(), CommandParser::Error::kTooManyCommands);
+}
+
+TEST(CommandParserTest, SplitsObjectsAroundPrepositions) {
+    CommandParser parser;
+    auto use = parser.parseInput("use the Crystal Lens on the mirror");
+    ASSERT_TRUE(use.isValid);
+    EXPECT_EQ(use.action, "use");
+    EXPECT_EQ(use.noun, "crystal lens");
+    EXPECT_EQ(use.object, SymbolTable::global().find("Crystal Lens"));
+    EXPECT_EQ(use.preposition, "on");
+    EXPECT_EQ(use.indirect, "mirror");
+
+    auto give = parser.parseInput("give silver key to elda");
+    EXPECT_EQ(give.noun, "silver key");
+    EXPECT_EQ(give.preposition, "to");
+    EXPECT_EQ(give.indirect, "elda");
+
+    // "of" stays inside names
+    auto take = parser.parseInput("take staff of lumos");
+    EXPECT_EQ(take.noun, "staff of lumos");
+    EXPECT_TRUE(take.preposition.empty());
+    EXPECT_TRUE(take.indirect.empty());
+}
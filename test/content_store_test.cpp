@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "content_store.h"
+#include "game_engine.h"
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::unique_ptr<const WorldContent> parseContent(const std::string& text) {
+    std::istringstream in(text);
+    return WorldContent::parse(in);
+}
+
+}  // namespace
+
+TEST(WorldContentTest, ParsesSectionsAndRejectsBadLines) {
+    auto content = parseContent(
+        "# fixes\n"
+        "[location Elder's House]\n"
+        "name = Elder Elda's House\n"
+        "[item Quest Scroll]\n"
+        "description = A brittle scroll.\n");
+
+    const auto* location = content->findLocation("Elder's House");
+    ASSERT_NE(location, nullptr);
+    EXPECT_EQ(location->name, "Elder Elda's House");
+    EXPECT_TRUE(location->description.empty());
+    ASSERT_NE(content->findItemDescription("Quest Scroll"), nullptr);
+    EXPECT_EQ(content->findLocation("Village Square"), nullptr);
+
+    EXPECT_THROW(parseContent("[location Elder's House]\nsmell = musty\n"), std::runtime_error);
+    EXPECT_THROW(parseContent("[npc Elda]\n"), std::runtime_error);
+}
+
+TEST(ContentStoreTest, RunningSessionSeesPublishedText) {
+    ContentStore store;
+    GameEngine engine;
+    engine.setContentStore(&store);
+    engine.start();
+
+    store.publish(parseContent(
+        "[location Elder's House]\n"
+        "description = Freshly swept floors.\n"
+        "[item Quest Scroll]\n"
+        "description = A brittle scroll.\n"));
+    EXPECT_EQ(store.getVersion(), 1u);
+
+    std::string look(engine.step("look").output);
+    EXPECT_NE(look.find("Elder's House"), std::string::npos);
+    EXPECT_NE(look.find("Freshly swept floors."), std::string::npos);
+    std::string examine(engine.step("examine quest scroll").output);
+    EXPECT_NE(examine.find("A brittle scroll."), std::string::npos);
+}
+
+TEST(ContentStoreTest, ReadersKeepTheirContentAcrossPublishes) {
+    ContentStore store;
+    store.publish(parseContent("[item Quest Scroll]\ndescription = first\n"));
+
+    ContentStore::Reader pinned(store);
+    store.publish(parseContent("[item Quest Scroll]\ndescription = second\n"));
+    EXPECT_EQ(*pinned->findItemDescription("Quest Scroll"), "first");
+    EXPECT_EQ(*ContentStore::Reader(store)->findItemDescription("Quest Scroll"), "second");
+
+    // Concurrent readers always see a complete definition
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                ContentStore::Reader reader(store);
+                const std::string* text = reader->findItemDescription("Quest Scroll");
+                ASSERT_NE(text, nullptr);
+                EXPECT_FALSE(text->empty());
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        store.publish(parseContent("[item Quest Scroll]\ndescription = v" + std::to_string(i) + "\n"));
+    }
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+}
+
+TEST(ContentStoreTest, ReplacedContentIsFreedOnceReadersLeave) {
+    ContentStore store;
+    auto pinned = std::make_unique<ContentStore::Reader>(store);
+    store.publish(parseContent("[item Quest Scroll]\ndescription = first\n"));
+    EXPECT_EQ(store.getRetiredCount(), 1u);
+
+    // Nothing else is published, so only collect() can free it
+    store.collect();
+    EXPECT_EQ(store.getRetiredCount(), 1u);
+    pinned.reset();
+    store.collect();
+    EXPECT_EQ(store.getRetiredCount(), 0u);
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include "game_engine.h"
+#include "game_world.h"
+#include "location_grid.h"
+#include "player.h"
+#include "procedural_region.h"
+#include "snapshot.h"
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+class GameEngineTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        opening_ = engine_.start();
+    }
+
+    GameEngine engine_;
+    GameEngine::TurnResult opening_;
+};
+
+TEST_F(GameEngineTest, StartShowsWelcomeAndLocation) {
+    EXPECT_TRUE(engine_.isRunning());
+    EXPECT_NE(opening_.output.find("Welcome to Eldoria"), std::string::npos);
+    EXPECT_NE(opening_.output.find("Elder's House"), std::string::npos);
+    EXPECT_FALSE(opening_.quit);
+}
+
+TEST_F(GameEngineTest, StepWithoutStartInitializes) {
+    GameEngine engine;
+    auto result = engine.step("look");
+    EXPECT_NE(result.output.find("Elder's House"), std::string::npos);
+    EXPECT_TRUE(engine.isRunning());
+}
+
+TEST_F(GameEngineTest, MovementReportsLocationChange) {
+    auto result = engine_.step("go north");
+    EXPECT_TRUE(result.locationChanged);
+    EXPECT_FALSE(result.inventoryChanged);
+    EXPECT_NE(result.output.find("Village Square"), std::string::npos);
+}
+
+TEST_F(GameEngineTest, PickupReportsInventoryChange) {
+    auto result = engine_.step("take quest scroll");
+    EXPECT_TRUE(result.inventoryChanged);
+    EXPECT_TRUE(result.worldChanged);
+    EXPECT_NE(result.output.find("Taken: Quest Scroll"), std::string::npos);
+}
+
+TEST_F(GameEngineTest, InvalidInputLeavesStateUnchanged) {
+    auto result = engine_.step("!!!");
+    EXPECT_FALSE(result.locationChanged);
+    EXPECT_FALSE(result.inventoryChanged);
+    EXPECT_NE(result.output.find("Invalid command"), std::string::npos);
+}
+
+TEST_F(GameEngineTest, QuitEndsGame) {
+    auto result = engine_.step("quit");
+    EXPECT_TRUE(result.quit);
+    EXPECT_FALSE(engine_.isRunning());
+}
+
+TEST_F(GameEngineTest, RiddleDialogTakesFollowUpLines) {
+    engine_.step("go north");
+    engine_.step("go north");
+    engine_.step("go north");
+
+    auto prompt = engine_.step("solve");
+    EXPECT_NE(prompt.output.find("Gorwin's Riddle"), std::string::npos);
+
+    // Dialog input is not parsed as a command
+    auto wrong = engine_.step("look");
+    EXPECT_NE(wrong.output.find("That is not the answer"), std::string::npos);
+
+    auto right = engine_.step("An Echo");
+    EXPECT_NE(right.output.find("Correct!"), std::string::npos);
+    EXPECT_TRUE(right.worldChanged);
+
+    // Back to normal commands once the dialog is over
+    auto look = engine_.step("look");
+    EXPECT_NE(look.output.find("Hermit's Hollow"), std::string::npos);
+}
+
+TEST_F(GameEngineTest, SolveWithoutPuzzle) {
+    auto result = engine_.step("solve");
+    EXPECT_NE(result.output.find("There is no puzzle here"), std::string::npos);
+}
+
+TEST_F(GameEngineTest, AbbreviationsAndSuggestions) {
+    EXPECT_NE(engine_.step("t scr").output.find("Taken: Quest Scroll"), std::string::npos);
+    EXPECT_NE(engine_.step("i").output.find("- Quest Scroll"), std::string::npos);
+    EXPECT_NE(engine_.step("exmine elda").output.find("Did you mean \"examine\"?"), std::string::npos);
+    EXPECT_NE(engine_.step("examine elsa").output.find("Did you mean \"Elda\"?"), std::string::npos);
+
+    // Names follow the player from room to room
+    auto moved = engine_.step("n");
+    EXPECT_TRUE(moved.locationChanged);
+    EXPECT_NE(engine_.step("ex eld").output.find("You don't see that here."), std::string::npos);
+    EXPECT_NE(engine_.step("ex scr").output.find("An ancient scroll"), std::string::npos);
+}
+
+TEST_F(GameEngineTest, BatchRunsInOrderAndShowsLocationOnce) {
+    auto batch = engine_.step("take quest scroll, go north then look");
+    std::string output(batch.output);
+    EXPECT_TRUE(batch.inventoryChanged);
+    EXPECT_TRUE(batch.locationChanged);
+    EXPECT_LT(output.find("Taken: Quest Scroll"), output.find("You move north."));
+    EXPECT_EQ(output.find("Exits:"), output.rfind("Exits:"));
+
+    // A failed command stops the rest of the batch
+    auto stopped = engine_.step("take lantern and go south");
+    EXPECT_FALSE(stopped.locationChanged);
+    EXPECT_NE(std::string(stopped.output).find("Stopped before \"go\"."), std::string::npos);
+}
+
+TEST_F(GameEngineTest, BatchTooLongIsRejectedWithAReason) {
+    std::string line = "look";
+    for (size_t i = 0; i < CommandParser::kMaxCommands; ++i) {
+        line += ", look";
+    }
+    std::string output(engine_.step(line).output);
+    EXPECT_NE(output.find("Too many commands in one line (at most 8)."), std::string::npos);
+    EXPECT_EQ(output.find("Invalid command"), std::string::npos);
+}
+
+TEST_F(GameEngineTest, GiveNeedsAnNpcThatWantsTheItem) {
+    engine_.step("take quest scroll");
+    EXPECT_NE(engine_.step("give scroll").output.find("to whom?"), std::string::npos);
+    EXPECT_NE(engine_.step("give the scroll to gorwin").output.find("You don't see that here."), std::string::npos);
+
+    auto refused = engine_.step("give scroll to eld");
+    EXPECT_FALSE(refused.inventoryChanged);
+    EXPECT_NE(refused.output.find("Elda has no use for the Quest Scroll."), std::string::npos);
+}
+
+TEST_F(GameEngineTest, CompletesVerbsExitsAndVisibleNames) {
+    auto verbs = engine_.complete("s");
+    EXPECT_EQ(verbs.replaceFrom, 0u);
+    ASSERT_EQ(verbs.candidates.size(), 2u);
+    EXPECT_EQ(verbs.candidates[0], "solve");
+    EXPECT_EQ(verbs.candidates[1], "south");
+
+    auto exits = engine_.complete("go ");
+    EXPECT_EQ(exits.replaceFrom, 3u);
+    EXPECT_EQ(exits.candidates.size(), 4u);
+
+    auto items = engine_.complete("take the SCR");
+    EXPECT_EQ(items.replaceFrom, 9u);
+    ASSERT_EQ(items.candidates.size(), 1u);
+    EXPECT_EQ(items.candidates[0], "Quest Scroll");
+
+    // After the preposition, NPCs complete too
+    engine_.step("take scroll");
+    auto npcs = engine_.complete("give scroll to e");
+    EXPECT_EQ(npcs.replaceFrom, 15u);
+    ASSERT_EQ(npcs.candidates.size(), 1u);
+    EXPECT_EQ(npcs.candidates[0], "Elda");
+
+    EXPECT_TRUE(engine_.complete("dance w").candidates.empty());
+}
+
+TEST_F(GameEngineTest, PrerenderedViewsMatchAndGoStaleOnChange) {
+    GameEngine fresh;
+    fresh.start();
+    engine_.prerender();
+    EXPECT_EQ(std::string(engine_.step("n").output), std::string(fresh.step("n").output));
+
+    // The house view cached from the square must not hide the dropped scroll
+    engine_.step("s");
+    engine_.step("take scroll");
+    engine_.step("n");
+    engine_.prerender();
+    EXPECT_EQ(engine_.step("s").output.find("Quest Scroll"), std::string::npos);
+    engine_.step("drop scroll");
+    engine_.step("n");
+    EXPECT_NE(engine_.step("s").output.find("- Quest Scroll"), std::string::npos);
+}
+
+TEST_F(GameEngineTest, PrerenderedViewsGoStaleWhenWildChunksAreReplaced) {
+    // Start a few chunks into the marsh wilds, away from the pinned entry
+    const std::string path = "/tmp/eldoria_engine_test_" + std::to_string(getpid()) + ".bin";
+    GameWorld world;
+    Player player("Aric", "A courageous adventurer destined to save Eldoria.");
+    ASSERT_TRUE(world.setCurrentLocation(9, LocationGrid::MAX_SIZE / 2, 4 * LocationGrid::CHUNK_SIZE));
+    Snapshot::save(world, player, path);
+    GameEngine fresh;
+    fresh.start();
+    fresh.loadSnapshot(path);
+    engine_.loadSnapshot(path);
+    std::remove(path.c_str());
+
+    // Walk far enough east for the chunks around the prerendered views to
+    // be evicted and generated again, then back over them; every view shown
+    // must be the room the player is in, whatever address it was given
+    engine_.prerender();
+    const int distance = (ProceduralRegion::EVICT_RADIUS + 2) * LocationGrid::CHUNK_SIZE;
+    for (int step = 1; step <= 2 * distance; ++step) {
+        const char* move = step <= distance ? "e" : "w";
+        auto result = engine_.step(move);
+        ASSERT_EQ(std::string(result.output), std::string(fresh.step(move).output)) << "step " << step;
+        // Entering a new chunk eastwards generates the next column of chunks
+        if (step <= distance && step % LocationGrid::CHUNK_SIZE == 0) {
+            EXPECT_TRUE(result.worldChanged) << "step " << step;
+        }
+    }
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include "game_server.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+const std::string kPrompt = "\n> ";
+
+}  // namespace
+
+class GameServerTest : public ::testing::Test {
+ protected:
+    void TearDown() override {
+        for (int fd : clients_) {
+            close(fd);
+        }
+        if (server_) {
+            server_->stop();
+            serverThread_.join();
+            server_.reset();
+        }
+    }
+
+    /**
+     * @brief Start a server on a private Unix socket and run it in the background
+     */
+    void startServer(size_t workerThreads, size_t maxLineLength = 4096) {
+        GameServer::Options options;
+        options.unixPath = "/tmp/eldoria_server_test_" + std::to_string(getpid()) + ".sock";
+        options.workerThreads = workerThreads;
+        options.maxLineLength = maxLineLength;
+        server_ = std::make_unique<GameServer>(options);
+        path_ = options.unixPath;
+        serverThread_ = std::thread([this] { server_->run(); });
+    }
+
+    /**
+     * @brief Connect a client and read the opening text
+     * @return The client socket
+     */
+    int connectClient() {
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path_.c_str(), sizeof(addr.sun_path) - 1);
+        EXPECT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+        clients_.push_back(fd);
+        EXPECT_NE(readResponse(fd).find("Welcome to Eldoria"), std::string::npos);
+        return fd;
+    }
+
+    /**
+     * @brief Send all of a text to the server
+     */
+    static void sendText(int fd, const std::string& text) {
+        size_t offset = 0;
+        while (offset < text.size()) {
+            ssize_t sent = send(fd, text.data() + offset, text.size() - offset, MSG_NOSIGNAL);
+            ASSERT_GT(sent, 0);
+            offset += static_cast<size_t>(sent);
+        }
+    }
+
+    /**
+     * @brief Read up to and including the next prompt
+     * @return The response, or everything read before the server closed
+     */
+    static std::string readResponse(int fd) {
+        std::string response;
+        char byte;
+        while (response.size() < kPrompt.size() ||
+               response.compare(response.size() - kPrompt.size(), kPrompt.size(), kPrompt) != 0) {
+            if (read(fd, &byte, 1) != 1) break;
+            response += byte;
+        }
+        return response;
+    }
+
+    /**
+     * @brief Wait for a client socket to have something to read
+     * @return false if nothing arrived in time
+     */
+    static bool waitReadable(int fd, std::chrono::milliseconds timeout) {
+        pollfd entry{fd, POLLIN, 0};
+        return poll(&entry, 1, static_cast<int>(timeout.count())) == 1;
+    }
+
+    std::unique_ptr<GameServer> server_;
+    std::thread serverThread_;
+    std::string path_;
+    std::vector<int> clients_;
+};
+
+TEST_F(GameServerTest, WaitingSessionIsAnsweredWhileWorkersAreBusy) {
+    startServer(1);
+    int waiting = connectClient();
+
+    // Keep the only worker busy for good: every busy player keeps at least a
+    // burst of turns queued, so the pool never runs out of regular work
+    const int kBusyPlayers = 4;
+    const int kBurst = 8000;
+    std::string burst;
+    for (int i = 0; i < kBurst; ++i) {
+        burst += "!!!\n";
+    }
+    std::atomic<bool> done{false};
+    std::vector<std::thread> players;
+    for (int i = 0; i < kBusyPlayers; ++i) {
+        int busy = connectClient();
+        players.emplace_back([busy, &burst, &done] {
+            int outstanding = 0;
+            char buffer[65536];
+            while (!done.load()) {
+                if (send(busy, burst.data(), burst.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(burst.size())) {
+                    return;
+                }
+                outstanding += kBurst;
+                while (outstanding > kBurst) {
+                    ssize_t received = read(busy, buffer, sizeof(buffer));
+                    if (received <= 0) return;
+                    // Each answer ends with the prompt; its last byte appears once per answer
+                    outstanding -= static_cast<int>(std::count(buffer, buffer + received, '>'));
+                }
+            }
+        });
+    }
+
+    // The first line leaves a prerender queued behind the busy players;
+    // the second must not wait for the pool to go idle
+    sendText(waiting, "look\n");
+    EXPECT_NE(readResponse(waiting).find("Elder's House"), std::string::npos);
+    sendText(waiting, "look\n");
+    bool answered = waitReadable(waiting, std::chrono::seconds(5));
+    EXPECT_TRUE(answered) << "waiting session stalled behind busy players";
+    if (answered) {
+        EXPECT_NE(readResponse(waiting).find("Elder's House"), std::string::npos);
+    }
+
+    done.store(true);
+    for (size_t i = 1; i < clients_.size(); ++i) {
+        shutdown(clients_[i], SHUT_RDWR);
+    }
+    for (auto& player : players) {
+        player.join();
+    }
+}
+
+TEST_F(GameServerTest, FramesLinesAcrossReads) {
+    startServer(1);
+    int client = connectClient();
+
+    // Two lines in one write, one of them with a CRLF terminator, then a
+    // line split over two writes
+    sendText(client, "go north\r\nlook\ninv");
+    EXPECT_NE(readResponse(client).find("Village Square"), std::string::npos);
+    EXPECT_NE(readResponse(client).find("Village Square"), std::string::npos);
+    sendText(client, "entory\n");
+    std::string inventory = readResponse(client);
+    EXPECT_EQ(inventory.find("Invalid command"), std::string::npos);
+    EXPECT_EQ(inventory.find("Village Square"), std::string::npos);
+}
+
+TEST_F(GameServerTest, RejectsOverlongLinesAndKeepsGoing) {
+    startServer(1, 64);
+    int client = connectClient();
+
+    // The overlong line arrives in pieces; only the first one is answered
+    sendText(client, std::string(100, 'a'));
+    sendText(client, std::string(100, 'b') + "\nlook\n");
+    EXPECT_NE(readResponse(client).find("Input line too long."), std::string::npos);
+    EXPECT_NE(readResponse(client).find("Elder's House"), std::string::npos);
+
+    // Or whole, newline included
+    sendText(client, std::string(100, 'c') + "\nlook\n");
+    EXPECT_NE(readResponse(client).find("Input line too long."), std::string::npos);
+    EXPECT_NE(readResponse(client).find("Elder's House"), std::string::npos);
+}
+
+TEST_F(GameServerTest, QuitClosesTheConnection) {
+    startServer(1);
+    int client = connectClient();
+
+    sendText(client, "quit\nlook\n");
+    std::string farewell = readResponse(client);
+    EXPECT_NE(farewell.find("Thank you for playing"), std::string::npos);
+    EXPECT_EQ(farewell.find(kPrompt), std::string::npos);
+
+    char byte;
+    EXPECT_EQ(read(client, &byte, 1), 0);
+}
+
+TEST_F(GameServerTest, AnswersPendingLinesBeforeClosing) {
+    startServer(1);
+    int client = connectClient();
+
+    // A client that stops sending still gets every framed line answered
+    sendText(client, "go north\nlook\n");
+    shutdown(client, SHUT_WR);
+    EXPECT_NE(readResponse(client).find("Village Square"), std::string::npos);
+    EXPECT_NE(readResponse(client).find("Village Square"), std::string::npos);
+
+    char byte;
+    EXPECT_EQ(read(client, &byte, 1), 0);
+}
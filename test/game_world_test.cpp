@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "game_world.h"
+
+TEST(GameWorldTest, MovingBetweenEnvironmentsUpdatesTheGrid) {
+    GameWorld world;
+    LocationGrid* village = world.getEnvironment(0);
+    LocationGrid* woods = world.getEnvironment(1);
+    ASSERT_EQ(world.getCurrentEnvironment(), village);
+
+    ASSERT_TRUE(world.move(Location::Direction::NORTH));
+    EXPECT_EQ(world.getLocationCoordinates(world.getCurrentLocation()), std::make_pair(1, 0));
+
+    // The village's north edge leads into the south of the woods
+    ASSERT_TRUE(world.move(Location::Direction::NORTH));
+    EXPECT_EQ(world.getCurrentEnvironment(), woods);
+    EXPECT_EQ(world.getCurrentLocation(), woods->getLocation(1, 2));
+    EXPECT_EQ(world.getLocationCoordinates(world.getCurrentLocation()), std::make_pair(1, 2));
+
+    ASSERT_TRUE(world.move(Location::Direction::SOUTH));
+    EXPECT_EQ(world.getCurrentEnvironment(), village);
+}
+
+TEST(GameWorldTest, CoordinatesOfForeignLocationsAreEmpty) {
+    GameWorld world;
+    Location loose("Loose", "Not in the world.");
+    EXPECT_EQ(world.getLocationCoordinates(&loose), std::nullopt);
+    EXPECT_EQ(world.getLocationCoordinates(world.getEnvironment(2)->getLocation(2, 1)), std::make_pair(2, 1));
+}
+
+TEST(GameWorldTest, EnvironmentsAreBuiltWhenApproached) {
+    GameWorld world;
+    EXPECT_EQ(world.getBuiltEnvironmentCount(), 1u);
+    EXPECT_EQ(world.findEnvironment(1), nullptr);
+
+    // Standing at the village's north exit builds the woods behind it
+    ASSERT_TRUE(world.move(Location::Direction::NORTH));
+    EXPECT_NE(world.findEnvironment(1), nullptr);
+    EXPECT_NE(world.getCurrentLocation()->getExit(Location::Direction::NORTH), nullptr);
+    EXPECT_EQ(world.findEnvironment(7), nullptr);
+}
+
+TEST(GameWorldTest, PrefetchBuildsAdjacentEnvironments) {
+    GameWorld world;
+    EXPECT_TRUE(world.prefetch());
+    EXPECT_NE(world.findEnvironment(1), nullptr);
+    EXPECT_EQ(world.getBuiltEnvironmentCount(), 2u);
+    EXPECT_FALSE(world.prefetch());
+}
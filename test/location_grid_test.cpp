@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "location_grid.h"
+#include "location_store.h"
+#include <stdexcept>
+
+TEST(LocationGridTest, LargeGridsOnlyAllocatePopulatedChunks) {
+    LocationStore store;
+    LocationGrid grid("Plains", LocationGrid::MAX_SIZE, 16);
+    EXPECT_EQ(grid.getWidth(), LocationGrid::MAX_SIZE);
+    EXPECT_EQ(grid.getChunkCount(), 0u);
+
+    Location* far = store.create("Far", "The far end.");
+    EXPECT_TRUE(grid.setLocation(4095, 15, far));
+    EXPECT_TRUE(grid.setLocation(0, 0, nullptr));
+    EXPECT_FALSE(grid.setLocation(4096, 0, far));
+    EXPECT_EQ(grid.getChunkCount(), 1u);
+    EXPECT_EQ(grid.getLocation(4095, 15), far);
+    EXPECT_EQ(grid.getLocation(4094, 15), nullptr);
+
+    EXPECT_THROW(LocationGrid("Too big", LocationGrid::MAX_SIZE + 1, 1), std::invalid_argument);
+}
+
+TEST(LocationGridTest, ConnectsAcrossChunkEdges) {
+    LocationStore store;
+    LocationGrid grid("Field", 20, 20);
+    for (int y = 6; y < 10; ++y) {
+        for (int x = 6; x < 10; ++x) {
+            grid.setLocation(x, y, store.create("Cell", "A cell."));
+        }
+    }
+    grid.connectGridLocations();
+    EXPECT_EQ(grid.getChunkCount(), 4u);
+
+    Location* corner = grid.getLocation(7, 7);
+    EXPECT_EQ(corner->getExit(Location::Direction::EAST), grid.getLocation(8, 7));
+    EXPECT_EQ(corner->getExit(Location::Direction::SOUTH), grid.getLocation(7, 8));
+    EXPECT_EQ(grid.getLocation(8, 8)->getExit(Location::Direction::NORTH), grid.getLocation(8, 7));
+    EXPECT_EQ(grid.getLocation(6, 6)->getExit(Location::Direction::WEST), nullptr);
+
+    int visited = 0;
+    grid.forEachLocation([&](int x, int y, Location* location) {
+        EXPECT_EQ(grid.getLocation(x, y), location);
+        ++visited;
+    });
+    EXPECT_EQ(visited, 16);
+}
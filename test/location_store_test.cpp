@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "location_store.h"
+
+TEST(LocationStoreTest, ExitsUseFixedSlots) {
+    LocationStore store;
+    Location* hall = store.create("Hall", "A hall.");
+    Location* yard = store.create("Yard", "A yard.");
+    Location* shed = store.create("Shed", "A shed.");
+
+    EXPECT_EQ(hall->getId(), 0u);
+    EXPECT_EQ(store.get(yard->getId()), yard);
+    EXPECT_EQ(store.get(kNoLocation), nullptr);
+
+    EXPECT_TRUE(hall->addExit(Location::Direction::WEST, yard));
+    EXPECT_TRUE(hall->addExit(Location::Direction::NORTH, shed));
+    EXPECT_FALSE(hall->addExit(Location::Direction::NORTH, yard));
+    EXPECT_EQ(hall->getExit(Location::Direction::NORTH), shed);
+    EXPECT_EQ(hall->getExit(Location::Direction::SOUTH), nullptr);
+    EXPECT_TRUE(hall->hasExit(Location::Direction::WEST));
+    EXPECT_EQ(store.getExit(hall->getId(), Location::Direction::WEST), yard->getId());
+
+    // Exits are listed in slot order, not insertion order
+    std::string description(hall->getFullDescription());
+    EXPECT_LT(description.find("North (to Shed)"), description.find("West (to Yard)"));
+}
+
+TEST(LocationStoreTest, RoomsOutsideTheStoreHaveNoExits) {
+    LocationStore store;
+    Location* hall = store.create("Hall", "A hall.");
+    Location loose("Loose", "Not in any store.");
+
+    EXPECT_EQ(loose.getId(), kNoLocation);
+    EXPECT_FALSE(hall->addExit(Location::Direction::EAST, &loose));
+    EXPECT_FALSE(loose.addExit(Location::Direction::WEST, hall));
+    EXPECT_EQ(loose.getExit(Location::Direction::WEST), nullptr);
+}
+
+TEST(LocationStoreTest, LayoutVersionFollowsRoomsAndExits) {
+    LocationStore store;
+    uint64_t version = store.getLayoutVersion();
+    Location* hall = store.create("Hall", "A hall.");
+    Location* yard = store.create("Yard", "A yard.");
+    EXPECT_GT(store.getLayoutVersion(), version);
+
+    version = store.getLayoutVersion();
+    EXPECT_TRUE(hall->addExit(Location::Direction::WEST, yard));
+    EXPECT_GT(store.getLayoutVersion(), version);
+
+    // A refused exit changes nothing
+    version = store.getLayoutVersion();
+    EXPECT_FALSE(hall->addExit(Location::Direction::WEST, hall));
+    EXPECT_EQ(store.getLayoutVersion(), version);
+
+    EXPECT_TRUE(store.destroy(yard->getId()));
+    EXPECT_GT(store.getLayoutVersion(), version);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "name_index.h"
+
+TEST(NameIndexTest, ResolvesUniquePrefixesOfAnyWord) {
+    NameIndex index;
+    index.insert("Quest Scroll");
+    index.insert("Crystal Lens");
+    index.insert("Crystal Shard");
+
+    EXPECT_EQ(index.resolve("scr"), "Quest Scroll");
+    EXPECT_EQ(index.resolve("quest scroll"), "Quest Scroll");
+    EXPECT_EQ(index.resolve("crystal l"), "Crystal Lens");
+    EXPECT_TRUE(index.resolve("crystal").empty());
+    EXPECT_TRUE(index.resolve("sword").empty());
+}
+
+TEST(NameIndexTest, SuggestsWithinEditDistance) {
+    NameIndex index;
+    index.insert("Quest Scroll");
+    index.insert("Elda");
+
+    EXPECT_EQ(index.suggest("qeust scroll", 2), "Quest Scroll");
+    EXPECT_EQ(index.suggest("elad", 2), "Elda");
+    EXPECT_TRUE(index.suggest("lantern", 2).empty());
+}
+
+TEST(NameIndexTest, CountsReferencesAcrossUpdates) {
+    NameIndex index;
+    index.insert("Quest Scroll");
+    index.insert("quest scroll");
+    EXPECT_EQ(index.size(), 1u);
+
+    index.erase("Quest Scroll");
+    EXPECT_EQ(index.resolve("scr"), "Quest Scroll");
+    index.erase("Quest Scroll");
+    EXPECT_TRUE(index.resolve("scr").empty());
+    EXPECT_EQ(index.size(), 0u);
+
+    index.insert("Scroll Case");
+    EXPECT_EQ(index.resolve("scr"), "Scroll Case");
+}
+
+TEST(NameIndexTest, CompleteListsEachNameOnceStartingMatchesFirst) {
+    NameIndex index;
+    index.insert("Staff of Sorrows");
+    index.insert("Silver Key");
+    index.insert("Quest Scroll");
+    index.insert("Stone");
+
+    std::vector<std::string_view> names;
+    index.complete("S", names);
+    ASSERT_EQ(names.size(), 4u);
+    EXPECT_EQ(names[0], "Silver Key");
+    EXPECT_EQ(names[1], "Staff of Sorrows");
+    EXPECT_EQ(names[2], "Stone");
+    EXPECT_EQ(names[3], "Quest Scroll");
+
+    names.clear();
+    index.complete("xyz", names);
+    EXPECT_TRUE(names.empty());
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "procedural_region.h"
+#include "game_world.h"
+#include "item.h"
+#include <memory>
+
+namespace {
+
+struct Wilds {
+    explicit Wilds(uint64_t seed)
+        : grid("Wilds", LocationGrid::MAX_SIZE, LocationGrid::MAX_SIZE),
+          region(EnvironmentType::MARSH_WILDS, seed, grid, store) {}
+
+    LocationStore store;
+    LocationGrid grid;
+    ProceduralRegion region;
+};
+
+}  // namespace
+
+TEST(ProceduralRegionTest, GenerationDependsOnlyOnSeedAndPosition) {
+    Wilds first(7), second(7), other(8);
+    bool differs = false;
+    for (int x = 100; x < 108; ++x) {
+        EXPECT_EQ(first.region.materialize(x, 50)->getName(), second.region.materialize(x, 50)->getName());
+        differs |= first.region.materialize(x, 50)->getName() != other.region.materialize(x, 50)->getName();
+    }
+    EXPECT_TRUE(differs);
+    EXPECT_EQ(first.region.materialize(LocationGrid::MAX_SIZE, 0), nullptr);
+}
+
+TEST(ProceduralRegionTest, MemoryFollowsThePlayer) {
+    Wilds wilds(7);
+    std::string start = wilds.region.materialize(2000, 2000)->getName();
+    for (int x = 2000; x < 2400; ++x) {
+        wilds.region.approach(x, 2000);
+        EXPECT_NE(wilds.grid.getLocation(x, 2000)->getExit(Location::Direction::EAST), nullptr);
+        EXPECT_LE(wilds.region.getResidentChunkCount(), 25u);
+    }
+    EXPECT_EQ(wilds.grid.getLocation(2000, 2000), nullptr);
+    EXPECT_EQ(wilds.store.getLiveCount(), wilds.region.getResidentChunkCount() * 64);
+
+    // Walking back regenerates the same place
+    EXPECT_EQ(wilds.region.materialize(2000, 2000)->getName(), start);
+}
+
+TEST(ProceduralRegionTest, ChangedAndAnchoredChunksStay) {
+    Wilds wilds(7);
+    Location* anchored = wilds.region.anchor(10, 10);
+    wilds.region.materialize(500, 500)->addItem(std::make_shared<Item>("stone", "Stone", "A stone."));
+    wilds.region.approach(3000, 3000);
+
+    EXPECT_EQ(wilds.grid.getLocation(10, 10), anchored);
+    ASSERT_NE(wilds.grid.getLocation(500, 500), nullptr);
+    EXPECT_EQ(wilds.grid.getLocation(500, 500)->getItems().size(), 1u);
+    EXPECT_EQ(wilds.region.getResidentChunkCount(), 9u + 2u);
+}
+
+TEST(ProceduralRegionTest, WorldLeadsIntoTheMarshWilds) {
+    GameWorld world;
+    ASSERT_TRUE(world.setCurrentLocation(5, 1, 2));
+    ASSERT_TRUE(world.move(Location::Direction::SOUTH));
+    EXPECT_EQ(world.getCurrentEnvironment(), world.getEnvironment(9));
+
+    for (int step = 0; step < 100; ++step) {
+        ASSERT_TRUE(world.move(Location::Direction::SOUTH));
+    }
+    EXPECT_EQ(world.getLocationCoordinates(world.getCurrentLocation()),
+              std::make_pair(LocationGrid::MAX_SIZE / 2, 100));
+}
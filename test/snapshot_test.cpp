@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "game_engine.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+class SnapshotTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        path_ = "/tmp/eldoria_snapshot_test_" + std::to_string(getpid()) + ".bin";
+        engine_.start();
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    std::string path_;
+    GameEngine engine_;
+};
+
+TEST_F(SnapshotTest, RestoresItemsLocationAndPuzzleProgress) {
+    engine_.step("go north");
+    engine_.step("go north");
+    engine_.step("go north");
+    engine_.step("take enchanted map");
+    engine_.step("solve");
+    engine_.step("a tree");
+    engine_.step("leave");
+    engine_.saveSnapshot(path_);
+
+    GameEngine restored;
+    restored.start();
+    restored.loadSnapshot(path_);
+
+    std::string look(restored.step("look").output);
+    EXPECT_NE(look.find("Hermit's Hollow"), std::string::npos);
+    EXPECT_EQ(look.find("Enchanted Map"), std::string::npos);
+
+    std::string inventory(restored.step("inventory").output);
+    EXPECT_NE(inventory.find("Enchanted Map"), std::string::npos);
+
+    // One of three riddle attempts was used before saving
+    restored.step("solve");
+    std::string answer(restored.step("a rock").output);
+    EXPECT_NE(answer.find("Attempts remaining: 1"), std::string::npos);
+    restored.step("leave");
+
+    // Untouched items stay where the world put them
+    restored.step("go south");
+    restored.step("go south");
+    std::string start(restored.step("go south").output);
+    EXPECT_NE(start.find("Quest Scroll"), std::string::npos);
+}
+
+TEST_F(SnapshotTest, ItemTakenFromStartIsGoneAfterRestore) {
+    engine_.step("take quest scroll");
+    engine_.saveSnapshot(path_);
+
+    GameEngine restored;
+    restored.loadSnapshot(path_);
+    std::string look(restored.step("look").output);
+    EXPECT_EQ(look.find("Quest Scroll"), std::string::npos);
+}
+
+TEST_F(SnapshotTest, RejectsCorruptFileAndKeepsSession) {
+    {
+        std::ofstream file(path_, std::ios::binary);
+        file << "definitely not a snapshot";
+    }
+    engine_.step("go north");
+
+    EXPECT_THROW(engine_.loadSnapshot(path_), std::runtime_error);
+    std::string look(engine_.step("look").output);
+    EXPECT_NE(look.find("Village Square"), std::string::npos);
+}
+
+TEST_F(SnapshotTest, MissingFileThrows) {
+    EXPECT_THROW(engine_.loadSnapshot(path_ + ".missing"), std::runtime_error);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "symbol_table.h"
+#include "location.h"
+#include "player.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(SymbolTableTest, InternIgnoresCaseAndFindDoesNotAdd) {
+    SymbolTable table;
+    Symbol scroll = table.intern("Quest Scroll");
+    EXPECT_NE(scroll, kNoSymbol);
+    EXPECT_EQ(table.intern("quest scroll"), scroll);
+    EXPECT_EQ(table.find("QUEST SCROLL"), scroll);
+    EXPECT_NE(table.intern("Crystal Lens"), scroll);
+
+    EXPECT_EQ(table.find("lantern"), kNoSymbol);
+    EXPECT_EQ(table.size(), 2u);
+}
+
+TEST(SymbolTableTest, LookupsCompareSymbols) {
+    Location room("Hall", "A hall.");
+    auto lens = std::make_shared<Item>("crystal_lens", "Crystal Lens", "A lens.");
+    room.addItem(lens);
+
+    Symbol name = SymbolTable::global().find("crystal lens");
+    EXPECT_EQ(room.getItem(name), lens);
+    EXPECT_EQ(room.getItem(kNoSymbol), nullptr);
+    EXPECT_EQ(lens->GetItemSymbol(), SymbolTable::global().find("CRYSTAL_LENS"));
+
+    Player player("Hero", "The player.");
+    player.addItem(room.removeItem(name));
+    EXPECT_TRUE(room.getItems().empty());
+    EXPECT_TRUE(player.hasItem(name));
+    EXPECT_TRUE(player.hasItem("Crystal lens"));
+}
+
+TEST(SymbolTableTest, FindSeesNamesInternedByOtherThreads) {
+    SymbolTable table;
+    const size_t kNames = 5000;
+    std::atomic<bool> failed{false};
+
+    // Readers check every name published so far while the table keeps growing
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i) {
+        readers.emplace_back([&table, &failed, kNames] {
+            size_t seen = 0;
+            while (seen < kNames) {
+                seen = table.size();
+                for (size_t name = 0; name < seen; ++name) {
+                    if (table.find("Name " + std::to_string(name)) != name + 1) {
+                        failed.store(true);
+                    }
+                }
+            }
+        });
+    }
+    for (size_t name = 0; name < kNames; ++name) {
+        EXPECT_EQ(table.intern("NAME " + std::to_string(name)), name + 1);
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_FALSE(failed.load());
+    EXPECT_EQ(table.size(), kNames);
+    EXPECT_EQ(table.find("name 4999"), kNames);
+    EXPECT_EQ(table.find("name 5000"), kNoSymbol);
+}
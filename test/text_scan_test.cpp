@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include "text_scan.h"
+#include <string>
+
+TEST(TextScanTest, FindsBytesAcrossVectorWidths) {
+    std::string text(100, 'x');
+    for (size_t position : {0u, 15u, 16u, 31u, 32u, 63u, 99u}) {
+        std::string copy = text;
+        copy[position] = '\n';
+        EXPECT_EQ(findByte(copy, '\n'), position);
+        EXPECT_EQ(findByte(copy, '\n', position + 1), std::string_view::npos);
+    }
+    EXPECT_EQ(findByte("", '\n'), std::string_view::npos);
+}
+
+TEST(TextScanTest, AcceptsCommandTextAndWellFormedUtf8) {
+    std::string longLine(70, 'a');
+    EXPECT_TRUE(isCommandText(longLine + " Take THE Scroll\t42"));
+    EXPECT_TRUE(isCommandText(longLine + " examine Lumi\xC3\xA8re \xE2\x9C\xA8 \xF0\x9F\x97\xA1"));
+
+    EXPECT_FALSE(isCommandText(longLine + "!"));
+    EXPECT_FALSE(isCommandText(longLine + "\x01"));
+    EXPECT_FALSE(isCommandText(longLine + "\xC0\xAF"));          // overlong '/'
+    EXPECT_FALSE(isCommandText(longLine + "\xED\xA0\x80"));      // surrogate
+    EXPECT_FALSE(isCommandText(longLine + "\xF4\x90\x80\x80"));  // past U+10FFFF
+    EXPECT_FALSE(isCommandText(longLine + "\xE2\x9C"));          // truncated
+    EXPECT_FALSE(isCommandText("\x80"));                         // stray continuation
+}
+
+TEST(TextScanTest, FoldsAsciiAndLatin1Capitals) {
+    std::string text = "TAKE the Quest Scroll from \xC3\x89lise and \xC3\x80" + std::string(40, 'Z') + " \xC3\x97";
+    foldCase(text);
+    EXPECT_EQ(text, "take the quest scroll from \xC3\xA9lise and \xC3\xA0" + std::string(40, 'z') + " \xC3\x97");
+}
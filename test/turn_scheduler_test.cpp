@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "turn_scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void waitFor(const std::atomic<int>& counter, int expected) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (counter.load() < expected && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+}  // namespace
+
+TEST(TurnSchedulerTest, RunsEverySubmittedTask) {
+    TurnScheduler scheduler(4);
+    std::atomic<int> done{0};
+
+    for (int i = 0; i < 1000; ++i) {
+        scheduler.submit([&done] { done.fetch_add(1); });
+    }
+
+    waitFor(done, 1000);
+    EXPECT_EQ(done.load(), 1000);
+}
+
+TEST(TurnSchedulerTest, TasksSubmittedByWorkersRun) {
+    TurnScheduler scheduler(2);
+    std::atomic<int> done{0};
+
+    scheduler.submit([&scheduler, &done] {
+        for (int i = 0; i < 100; ++i) {
+            scheduler.submit([&done] { done.fetch_add(1); });
+        }
+    });
+
+    waitFor(done, 100);
+    EXPECT_EQ(done.load(), 100);
+}
+
+TEST(TurnSchedulerTest, SlowTaskDoesNotBlockOthers) {
+    TurnScheduler scheduler(2);
+    std::atomic<bool> release{false};
+    std::atomic<int> done{0};
+
+    scheduler.submit([&release] {
+        while (!release.load()) std::this_thread::yield();
+    });
+    for (int i = 0; i < 10; ++i) {
+        scheduler.submit([&done] { done.fetch_add(1); });
+    }
+
+    waitFor(done, 10);
+    EXPECT_EQ(done.load(), 10);
+    release.store(true);
+}
+
+TEST(TurnSchedulerTest, DestructorDrainsQueuedTasks) {
+    std::atomic<int> done{0};
+    {
+        TurnScheduler scheduler(3);
+        for (int i = 0; i < 500; ++i) {
+            scheduler.submit([&done] { done.fetch_add(1); });
+        }
+    }
+    EXPECT_EQ(done.load(), 500);
+}
+
+TEST(TurnSchedulerTest, RequeuedTasksTakeTurns) {
+    TurnScheduler scheduler(1);
+    std::atomic<bool> release{false};
+    std::atomic<int> done{0};
+    std::mutex mutex;
+    std::vector<int> order;
+
+    // Two busy sessions that each give up the worker after every slice
+    std::function<void(int, int)> slice = [&](int session, int remaining) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(session);
+        }
+        if (remaining > 1) {
+            scheduler.requeue([&slice, session, remaining] { slice(session, remaining - 1); });
+        } else {
+            done.fetch_add(1);
+        }
+    };
+
+    // Hold the only worker until both sessions are queued
+    scheduler.submit([&release] {
+        while (!release.load()) std::this_thread::yield();
+    });
+    scheduler.submit([&slice] { slice(1, 5); });
+    scheduler.submit([&slice] { slice(2, 5); });
+    release.store(true);
+
+    waitFor(done, 2);
+    ASSERT_EQ(order.size(), 10u);
+    for (size_t i = 1; i < order.size(); ++i) {
+        EXPECT_NE(order[i], order[i - 1]) << "slice " << i;
+    }
+}
+
+TEST(TurnSchedulerTest, OutsideTasksRunOldestFirst) {
+    TurnScheduler scheduler(1);
+    std::atomic<bool> release{false};
+    std::atomic<int> done{0};
+    std::mutex mutex;
+    std::vector<int> order;
+
+    // Hold the only worker while the first tasks queue up, then keep newer
+    // ones arriving while it works through them
+    scheduler.submit([&release] {
+        while (!release.load()) std::this_thread::yield();
+    });
+    const int kTasks = 200;
+    std::thread feeder([&] {
+        for (int i = 0; i < kTasks; ++i) {
+            scheduler.submit([&, i] {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    order.push_back(i);
+                }
+                done.fetch_add(1);
+            });
+            if (i == kTasks / 4) release.store(true);
+        }
+    });
+
+    waitFor(done, kTasks);
+    feeder.join();
+    ASSERT_EQ(order.size(), static_cast<size_t>(kTasks));
+    EXPECT_TRUE(std::is_sorted(order.begin(), order.end())) << "first task run: " << order.front();
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "verb_table.h"
+#include <array>
+#include <string_view>
+
+namespace {
+
+using Handler = int (*)();
+
+constexpr size_t kGenerated = 200;
+
+// "v000 w000" ... "v199 w199": storage for a name and an alias per verb
+constexpr auto kWords = [] {
+    std::array<std::array<char, 9>, kGenerated> words{};
+    for (size_t i = 0; i < kGenerated; ++i) {
+        char digits[3] = {char('0' + i / 100), char('0' + i / 10 % 10), char('0' + i % 10)};
+        words[i] = {'v', digits[0], digits[1], digits[2], ' ', 'w', digits[0], digits[1], digits[2]};
+    }
+    return words;
+}();
+
+constexpr auto kGeneratedVerbs = [] {
+    std::array<Verb<Handler>, kGenerated> verbs{};
+    for (size_t i = 0; i < kGenerated; ++i) {
+        std::string_view words(kWords[i].data(), kWords[i].size());
+        verbs[i] = {words.substr(0, 4), words.substr(5), "", "Generated", "", nullptr};
+    }
+    return verbs;
+}();
+
+constexpr VerbTable<Handler, kGenerated, countWords(kGeneratedVerbs)> kGeneratedTable{kGeneratedVerbs};
+
+constexpr auto kSmallVerbs = std::to_array<Verb<Handler>>({
+    {"go", "move walk", "[direction]", "Movement", "Move", [] { return 1; }},
+    {"look", "", "", "Environment", "Look", [] { return 2; }},
+});
+
+constexpr VerbTable<Handler, kSmallVerbs.size(), countWords(kSmallVerbs)> kSmallTable{kSmallVerbs};
+
+static_assert(kSmallTable.find("walk") == &kSmallTable.getVerbs()[0]);
+static_assert(kSmallTable.find("run") == nullptr);
+
+}  // namespace
+
+TEST(VerbTableTest, FindsNamesAndAliases) {
+    EXPECT_EQ(kSmallTable.find("move")->handler(), 1);
+    EXPECT_EQ(kSmallTable.find("look")->handler(), 2);
+    EXPECT_EQ(kSmallTable.find(""), nullptr);
+    EXPECT_EQ(kSmallTable.find("lookk"), nullptr);
+}
+
+TEST(VerbTableTest, ScalesToHundredsOfWords) {
+    for (size_t i = 0; i < kGenerated; ++i) {
+        const auto& verb = kGeneratedVerbs[i];
+        EXPECT_EQ(kGeneratedTable.find(verb.name), &kGeneratedTable.getVerbs()[i]);
+        EXPECT_EQ(kGeneratedTable.find(verb.aliases), &kGeneratedTable.getVerbs()[i]);
+    }
+    EXPECT_EQ(kGeneratedTable.find("v200"), nullptr);
+}